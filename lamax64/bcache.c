@@ -0,0 +1,387 @@
+/*
+ * LAMAX64 OS - Tampon Önbelleği
+ * Version 1.0.0
+ *
+ * Blok aygıtlarının 4 KB'lık bloklarını (aygıt, blok) anahtarıyla
+ * önbellekte tutar. Arama karma tablosuyla yapılır; yer gerektiğinde
+ * en uzun süredir kullanılmayan (LRU) referanssız blok, temizse
+ * doğrudan, kirliyse yazıldıktan sonra yeniden kullanılır. Kirli
+ * bloklar flush zamanlayıcısıyla arka planda (asenkron) yazılır:
+ * zamanlayıcı IRQ'da yalnızca bayrak kaldırır, gönderim boşta döngüsünde
+ * (bcache_idle) yapılır. ide gibi eşzamanlı sürücülerde gönderim yazmanın
+ * kendisidir ve kesme bağlamında yapılamaz.
+ */
+
+#include "system.h"
+
+static uint8_t bcache_data[BCACHE_BLOCKS][BCACHE_BLOCK_SIZE] __attribute__((aligned(BCACHE_BLOCK_SIZE)));
+static buffer_t bcache_buffers[BCACHE_BLOCKS];
+static buffer_t* bcache_hash[BCACHE_HASH_SIZE];
+
+// lru_head en son kullanılan, lru_tail çıkarma adayı
+static buffer_t* lru_head = NULL;
+static buffer_t* lru_tail = NULL;
+
+static bcache_stats_t bcache_stats;
+static ktimer_t bcache_flush_timer;
+static uint32_t bcache_flush_interval_ms = BCACHE_FLUSH_INTERVAL_MS;
+static volatile bool bcache_flush_pending = false;
+
+static inline uint32_t bcache_hash_index(block_device_t* device, uint64_t block) {
+    uint32_t key = (uint32_t)(uintptr_t)device ^ (uint32_t)block ^ (uint32_t)(block >> 32);
+    return (key * 2654435761u) >> (32 - BCACHE_HASH_BITS);
+}
+
+static void lru_unlink(buffer_t* buffer) {
+    if(buffer->lru_prev) buffer->lru_prev->lru_next = buffer->lru_next;
+    else lru_head = buffer->lru_next;
+    if(buffer->lru_next) buffer->lru_next->lru_prev = buffer->lru_prev;
+    else lru_tail = buffer->lru_prev;
+}
+
+static void lru_push_front(buffer_t* buffer) {
+    buffer->lru_prev = NULL;
+    buffer->lru_next = lru_head;
+    if(lru_head) lru_head->lru_prev = buffer;
+    else lru_tail = buffer;
+    lru_head = buffer;
+}
+
+static void bcache_hash_remove(buffer_t* buffer) {
+    buffer_t** link = &bcache_hash[bcache_hash_index(buffer->device, buffer->block)];
+    while(*link && *link != buffer) link = &(*link)->hash_next;
+    if(*link) *link = buffer->hash_next;
+    buffer->hash_next = NULL;
+}
+
+static buffer_t* bcache_lookup(block_device_t* device, uint64_t block) {
+    buffer_t* buffer = bcache_hash[bcache_hash_index(device, block)];
+    while(buffer && (buffer->device != device || buffer->block != block)) buffer = buffer->hash_next;
+    return buffer;
+}
+
+// Bloğun aygıttaki sektör aralığı; son blok aygıt sonunda kısalabilir
+static uint32_t bcache_sectors(buffer_t* buffer, uint64_t* lba) {
+    *lba = buffer->block * BCACHE_BLOCK_SECTORS;
+    if(*lba >= buffer->device->sectors) return 0;
+
+    uint64_t left = buffer->device->sectors - *lba;
+    return left < BCACHE_BLOCK_SECTORS ? (uint32_t)left : BCACHE_BLOCK_SECTORS;
+}
+
+static void bcache_write_complete(block_request_t* request) {
+    buffer_t* buffer = (buffer_t*)request->private_data;
+
+    // Yazma hatasında veri kaybolmasın: bir sonraki flush'ta yeniden dene
+    if(request->status != 0) {
+        buffer->flags |= BUFFER_DIRTY;
+        bcache_stats.write_errors++;
+    }
+    buffer->flags &= ~BUFFER_WRITEBACK;
+}
+
+// Kesmeler kapalıyken: isteği hazırla ve bloğu yazılıyor olarak işaretle
+static bool bcache_prepare_write(buffer_t* buffer) {
+    block_request_t* request = &buffer->request;
+    uint64_t lba;
+    uint32_t count = bcache_sectors(buffer, &lba);
+    if(count == 0) return false;
+
+    request->lba = lba;
+    request->count = count;
+    request->buffer = buffer->data;
+    request->write = true;
+    request->complete = bcache_write_complete;
+    request->private_data = buffer;
+    request->next = NULL;
+
+    buffer->flags = (buffer->flags & ~BUFFER_DIRTY) | BUFFER_WRITEBACK;
+    bcache_stats.writebacks++;
+    return true;
+}
+
+// Kirli blokları aygıt başına tek liste halinde gönder (device NULL: hepsi).
+// Kesme tamamlanmalı aygıtlarda beklemez; ide'de yazma burada biter, bu
+// yüzden kesme bağlamından çağrılmaz.
+static void bcache_start_writeback(block_device_t* device) {
+    for(block_device_t* target = block_first(); target; target = target->next) {
+        if(device && target != device) continue;
+
+        block_request_t* requests = NULL;
+        bool enabled = interrupts_enabled;
+
+        disable_interrupts();
+        for(int i = 0; i < BCACHE_BLOCKS; i++) {
+            buffer_t* buffer = &bcache_buffers[i];
+            if(buffer->device != target || (buffer->flags & (BUFFER_DIRTY | BUFFER_WRITEBACK)) != BUFFER_DIRTY) {
+                continue;
+            }
+            if(!bcache_prepare_write(buffer)) continue;
+            buffer->request.next = requests;
+            requests = &buffer->request;
+        }
+        if(enabled) enable_interrupts();
+
+        if(requests && block_submit(target, requests) != 0) {
+            // Gönderilemedi: blokları yeniden kirli işaretle
+            while(requests) {
+                block_request_t* next = requests->next;
+                buffer_t* buffer = (buffer_t*)requests->private_data;
+                buffer->flags = (buffer->flags & ~BUFFER_WRITEBACK) | BUFFER_DIRTY;
+                requests = next;
+            }
+        }
+    }
+}
+
+// Referanssız, yazılmayan bloklardan LRU sonundakini seç; temiz olan öncelikli
+static buffer_t* bcache_victim() {
+    buffer_t* dirty = NULL;
+
+    for(buffer_t* buffer = lru_tail; buffer; buffer = buffer->lru_prev) {
+        if(buffer->refcount || (buffer->flags & BUFFER_WRITEBACK)) continue;
+        if(!(buffer->flags & BUFFER_DIRTY)) return buffer;
+        if(!dirty) dirty = buffer;
+    }
+    return dirty;
+}
+
+// Bloğu önbellekte bul ya da yer aç; önden okuma isabet sayacına girmez
+static buffer_t* bcache_acquire(block_device_t* device, uint64_t block, bool count) {
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    buffer_t* buffer = bcache_lookup(device, block);
+    if(buffer) {
+        if(count) bcache_stats.hits++;
+        buffer->refcount++;
+        lru_unlink(buffer);
+        lru_push_front(buffer);
+        if(enabled) enable_interrupts();
+        return buffer;
+    }
+
+    if(count) bcache_stats.misses++;
+    buffer = bcache_victim();
+    if(!buffer) {
+        if(enabled) enable_interrupts();
+        return NULL;
+    }
+
+    // Kirli kurban: yerinde yaz, bitene kadar sabitle
+    if(buffer->flags & BUFFER_DIRTY) {
+        buffer->refcount++;
+        bool queued = bcache_prepare_write(buffer);
+        if(enabled) enable_interrupts();
+
+        if(queued && block_submit(buffer->device, &buffer->request) == 0) {
+            block_wait(buffer->device, &buffer->request);
+        } else {
+            buffer->flags &= ~BUFFER_WRITEBACK;
+        }
+
+        disable_interrupts();
+        buffer->refcount--;
+        if(buffer->flags & BUFFER_DIRTY) {
+            // Yazılamadı: bu bloğu atamayız
+            if(enabled) enable_interrupts();
+            return NULL;
+        }
+    }
+
+    if(buffer->device) {
+        bcache_hash_remove(buffer);
+        bcache_stats.evictions++;
+    }
+
+    uint32_t index = bcache_hash_index(device, block);
+    buffer->device = device;
+    buffer->block = block;
+    buffer->flags = 0;
+    buffer->refcount = 1;
+    buffer->hash_next = bcache_hash[index];
+    bcache_hash[index] = buffer;
+    lru_unlink(buffer);
+    lru_push_front(buffer);
+
+    if(enabled) enable_interrupts();
+    return buffer;
+}
+
+// Veri geçerli olmayabilir (BUFFER_VALID); bloğun tamamı yazılacaksa
+// okumadan yer almak için
+buffer_t* bcache_get(block_device_t* device, uint64_t block) {
+    return bcache_acquire(device, block, true);
+}
+
+// Bloğu geçerli veriyle döndür; okuma hatasında NULL
+buffer_t* bcache_read(block_device_t* device, uint64_t block) {
+    buffer_t* buffer = bcache_get(device, block);
+    if(!buffer) return NULL;
+
+    // Önden okuma sürüyorsa onu bekle
+    if(buffer->flags & BUFFER_READING) block_wait(device, &buffer->request);
+    if(buffer->flags & BUFFER_VALID) return buffer;
+
+    uint64_t lba;
+    uint32_t count = bcache_sectors(buffer, &lba);
+    if(count == 0 || block_read(device, lba, count, buffer->data) != 0) {
+        bcache_release(buffer);
+        return NULL;
+    }
+
+    // Aygıt sonunda kısa kalan blok sıfırla doldurulur
+    for(uint32_t i = count * BLOCK_SECTOR_SIZE; i < BCACHE_BLOCK_SIZE; i++) buffer->data[i] = 0;
+    buffer->flags |= BUFFER_VALID;
+    return buffer;
+}
+
+static void bcache_prefetch_complete(block_request_t* request) {
+    buffer_t* buffer = (buffer_t*)request->private_data;
+    uint64_t lba;
+    uint32_t count = bcache_sectors(buffer, &lba);
+
+    if(request->status == 0) {
+        for(uint32_t i = count * BLOCK_SECTOR_SIZE; i < BCACHE_BLOCK_SIZE; i++) buffer->data[i] = 0;
+        buffer->flags |= BUFFER_VALID;
+    }
+    buffer->flags &= ~BUFFER_READING;
+    bcache_release(buffer);
+}
+
+// [block, block + count) aralığında önbellekte olmayan blokları tek
+// liste halinde asenkron oku; gönderilen blok sayısını döndürür.
+// Bloklar okuma bitene kadar referanslı kalır (çıkarılmaz).
+uint32_t bcache_prefetch(block_device_t* device, uint64_t block, uint32_t count) {
+    block_request_t* requests = NULL;
+    block_request_t** tail = &requests;
+    uint32_t issued = 0;
+
+    for(uint32_t i = 0; i < count; i++) {
+        buffer_t* buffer = bcache_acquire(device, block + i, false);
+        if(!buffer) break;
+
+        uint64_t lba;
+        uint32_t sectors = bcache_sectors(buffer, &lba);
+        if(sectors == 0 || (buffer->flags & (BUFFER_VALID | BUFFER_READING))) {
+            bcache_release(buffer);
+            if(sectors == 0) break;
+            continue;
+        }
+
+        block_request_t* request = &buffer->request;
+        request->lba = lba;
+        request->count = sectors;
+        request->buffer = buffer->data;
+        request->write = false;
+        request->complete = bcache_prefetch_complete;
+        request->private_data = buffer;
+        request->next = NULL;
+        buffer->flags |= BUFFER_READING;
+
+        *tail = request;
+        tail = &request->next;
+        issued++;
+    }
+
+    if(requests && block_submit(device, requests) != 0) {
+        while(requests) {
+            block_request_t* next = requests->next;
+            buffer_t* buffer = (buffer_t*)requests->private_data;
+            buffer->flags &= ~BUFFER_READING;
+            bcache_release(buffer);
+            requests = next;
+        }
+        return 0;
+    }
+
+    bcache_stats.readahead += issued;
+    return issued;
+}
+
+void bcache_dirty(buffer_t* buffer) {
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    buffer->flags |= BUFFER_VALID | BUFFER_DIRTY;
+    if(enabled) enable_interrupts();
+}
+
+void bcache_release(buffer_t* buffer) {
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    if(buffer->refcount) buffer->refcount--;
+    if(enabled) enable_interrupts();
+}
+
+// Kirli blokları yaz, bitmelerini bekle ve aygıt önbelleğini boşalt
+int bcache_sync(block_device_t* device) {
+    int result = 0;
+
+    bcache_start_writeback(device);
+    for(int i = 0; i < BCACHE_BLOCKS; i++) {
+        buffer_t* buffer = &bcache_buffers[i];
+        if(!buffer->device || (device && buffer->device != device)) continue;
+
+        if(buffer->flags & BUFFER_WRITEBACK) block_wait(buffer->device, &buffer->request);
+        if(buffer->flags & BUFFER_DIRTY) result = -1;
+    }
+
+    for(block_device_t* target = block_first(); target; target = target->next) {
+        if(device && target != device) continue;
+        if(block_flush(target) != 0) result = -1;
+    }
+    return result;
+}
+
+// IRQ bağlamı: yalnızca işaretle, yazmayı bcache_idle yapar
+static void bcache_flush_tick(void* arg) {
+    (void)arg;
+    bcache_flush_pending = true;
+    ktimer_start(&bcache_flush_timer, bcache_flush_interval_ms * 1000, bcache_flush_tick, NULL);
+}
+
+// Boşta döngüsünden (keyboard_set_idle) kesmeler açıkken çağrılır
+void bcache_idle() {
+    if(!bcache_flush_pending) return;
+
+    bcache_flush_pending = false;
+    bcache_start_writeback(NULL);
+}
+
+// 0: periyodik yazma kapalı (yalnızca bcache_sync ve çıkarma yazar)
+void bcache_set_flush_interval(uint32_t interval_ms) {
+    bcache_flush_interval_ms = interval_ms;
+    ktimer_cancel(&bcache_flush_timer);
+    if(interval_ms) ktimer_start(&bcache_flush_timer, interval_ms * 1000, bcache_flush_tick, NULL);
+}
+
+void bcache_get_stats(bcache_stats_t* stats) {
+    *stats = bcache_stats;
+    stats->dirty = 0;
+    for(int i = 0; i < BCACHE_BLOCKS; i++) {
+        if(bcache_buffers[i].flags & BUFFER_DIRTY) stats->dirty++;
+    }
+}
+
+void bcache_init() {
+    lru_head = NULL;
+    lru_tail = NULL;
+    for(int i = 0; i < BCACHE_HASH_SIZE; i++) bcache_hash[i] = NULL;
+
+    for(int i = 0; i < BCACHE_BLOCKS; i++) {
+        buffer_t* buffer = &bcache_buffers[i];
+        buffer->device = NULL;
+        buffer->block = 0;
+        buffer->data = bcache_data[i];
+        buffer->flags = 0;
+        buffer->refcount = 0;
+        buffer->hash_next = NULL;
+        lru_push_front(buffer);
+    }
+
+    bcache_stats = (bcache_stats_t){0};
+    bcache_flush_timer.active = false;
+    bcache_set_flush_interval(bcache_flush_interval_ms);
+}
@@ -0,0 +1,306 @@
+/*
+ * LAMAX64 OS - Blok Aygıt Katmanı
+ * Version 1.0.0
+ *
+ * Disk sürücüleri (ATA, virtio-blk, NVMe) kendilerini burada kaydeder.
+ * Çağıranlar sürücüyü bilmeden istek listesi gönderir; istekler aygıtın
+ * kuyruğunda LBA sırasında bekler ve asansör (C-SCAN) sırasıyla, süresi
+ * dolan istek varsa önce o olmak üzere sürücüye verilir. LBA'sı ve
+ * belleği bitişik istekler tek sürücü isteğinde birleşir. Tamamlanma
+ * complete geri çağrısıyla bildirilir; senkron okuma/yazma tek istekli
+ * bir listeyi gönderip tamamlanmasını bekler.
+ *
+ * Kuyruk yalnızca yerel kesmeler kapatılarak korunur (tek işlemci).
+ */
+
+#include "system.h"
+
+static block_device_t* block_devices = NULL;
+static block_device_t* block_devices_tail = NULL;
+
+static void block_queue_init(block_device_t* device) {
+    block_queue_t* queue = &device->queue;
+
+    queue->sorted = NULL;
+    queue->fifo_head = NULL;
+    queue->fifo_tail = NULL;
+    queue->position = 0;
+    queue->in_flight = 0;
+    queue->running = false;
+    queue->rerun = false;
+    queue->submitted = 0;
+    queue->dispatched = 0;
+    queue->merged = 0;
+
+    queue->depth = device->queue_depth;
+    if(queue->depth == 0) queue->depth = 1;
+    if(queue->depth > BLOCK_QUEUE_DEPTH) queue->depth = BLOCK_QUEUE_DEPTH;
+
+    queue->free_slots = NULL;
+    for(int i = BLOCK_QUEUE_DEPTH - 1; i >= 0; i--) {
+        queue->slots[i].next = queue->free_slots;
+        queue->free_slots = &queue->slots[i];
+    }
+}
+
+// Kayıt sırası korunur: ilk kaydedilen açılış diskidir
+void block_register(block_device_t* device) {
+    block_queue_init(device);
+
+    device->next = NULL;
+    if(block_devices_tail) block_devices_tail->next = device;
+    else block_devices = device;
+    block_devices_tail = device;
+}
+
+block_device_t* block_find(const char* name) {
+    for(block_device_t* device = block_devices; device; device = device->next) {
+        const char* a = device->name;
+        const char* b = name;
+        while(*a && *a == *b) { a++; b++; }
+        if(*a == *b) return device;
+    }
+    return NULL;
+}
+
+block_device_t* block_first() {
+    return block_devices;
+}
+
+// LBA sırasına ekle (eşitler varış sırasını korur) ve FIFO'nun sonuna koy
+static void block_queue_insert(block_queue_t* queue, block_request_t* request) {
+    block_request_t** link = &queue->sorted;
+    while(*link && (*link)->lba <= request->lba) link = &(*link)->next;
+    request->next = *link;
+    *link = request;
+
+    request->fifo_next = NULL;
+    if(queue->fifo_tail) queue->fifo_tail->fifo_next = request;
+    else queue->fifo_head = request;
+    queue->fifo_tail = request;
+}
+
+static void block_queue_remove(block_queue_t* queue, block_request_t* request) {
+    block_request_t** link = &queue->sorted;
+    while(*link != request) link = &(*link)->next;
+    *link = request->next;
+
+    block_request_t* previous = NULL;
+    link = &queue->fifo_head;
+    while(*link != request) {
+        previous = *link;
+        link = &(*link)->fifo_next;
+    }
+    *link = request->fifo_next;
+    if(queue->fifo_tail == request) queue->fifo_tail = previous;
+}
+
+// Süresi dolan en eski istek önce; yoksa konumdan ileri ilk istek,
+// sona gelindiyse en küçük LBA (C-SCAN)
+static block_request_t* block_queue_pick(block_queue_t* queue) {
+    if(ktime_expired(queue->fifo_head->deadline)) return queue->fifo_head;
+
+    for(block_request_t* request = queue->sorted; request; request = request->next) {
+        if(request->lba >= queue->position) return request;
+    }
+    return queue->sorted;
+}
+
+static void block_queue_complete(block_request_t* slot);
+
+// Bir sürücü isteği oluştur: seçilen isteğe LBA ve bellekte bitişik
+// aynı yöndeki ardılları max_sectors'a kadar ekle
+static block_request_t* block_queue_dispatch(block_device_t* device) {
+    block_queue_t* queue = &device->queue;
+    block_request_t* first = block_queue_pick(queue);
+    block_request_t* candidate = first->next;
+    block_request_t* last = first;
+    uint32_t count = first->count;
+
+    block_queue_remove(queue, first);
+    while(candidate && candidate->lba == first->lba + count && candidate->write == first->write &&
+          (uint8_t*)candidate->buffer == (uint8_t*)first->buffer + count * BLOCK_SECTOR_SIZE &&
+          count + candidate->count <= device->max_sectors) {
+        block_request_t* following = candidate->next;
+        block_queue_remove(queue, candidate);
+        last->next = candidate;
+        last = candidate;
+        count += candidate->count;
+        queue->merged++;
+        candidate = following;
+    }
+    last->next = NULL;
+
+    block_request_t* slot = queue->free_slots;
+    queue->free_slots = slot->next;
+    slot->lba = first->lba;
+    slot->count = count;
+    slot->buffer = first->buffer;
+    slot->write = first->write;
+    slot->status = BLOCK_PENDING;
+    slot->complete = block_queue_complete;
+    slot->private_data = first;
+    slot->device = device;
+    slot->next = NULL;
+
+    queue->position = first->lba + count;
+    queue->in_flight++;
+    queue->dispatched++;
+    return slot;
+}
+
+// Sürücünün boş yeri kadar isteği tek listede gönder. Senkron sürücüler
+// tamamlanmayı submit içinde bildirir: iç içe çağrı yalnızca rerun'ı
+// işaretler ve dış döngü yeniden dener.
+static void block_queue_run(block_device_t* device) {
+    block_queue_t* queue = &device->queue;
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    if(queue->running) {
+        queue->rerun = true;
+        if(enabled) enable_interrupts();
+        return;
+    }
+    queue->running = true;
+
+    do {
+        queue->rerun = false;
+
+        block_request_t* batch = NULL;
+        block_request_t** tail = &batch;
+        while(queue->sorted && queue->in_flight < queue->depth) {
+            block_request_t* slot = block_queue_dispatch(device);
+            *tail = slot;
+            tail = &slot->next;
+        }
+
+        if(batch) {
+            // PIO aktarımı kesmeleri uzun süre kapalı tutmasın
+            if(enabled) enable_interrupts();
+            device->submit(device, batch);
+            disable_interrupts();
+        }
+    } while(queue->rerun);
+
+    queue->running = false;
+    if(enabled) enable_interrupts();
+}
+
+// Sürücü isteği bitti: birleşen isteklerin hepsine sonucu ilet
+static void block_queue_complete(block_request_t* slot) {
+    block_device_t* device = slot->device;
+    block_queue_t* queue = &device->queue;
+    block_request_t* request = slot->private_data;
+    int status = slot->status;
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    slot->next = queue->free_slots;
+    queue->free_slots = slot;
+    queue->in_flight--;
+
+    while(request) {
+        // complete isteği yeniden kullanabilir: sonrakini önceden al
+        block_request_t* next = request->next;
+        request->status = status;
+        if(request->complete) request->complete(request);
+        request = next;
+    }
+    if(enabled) enable_interrupts();
+
+    block_queue_run(device);
+}
+
+// Tüm istekleri BLOCK_PENDING yapıp kuyruğa al, sonra sürücüye ver
+int block_submit(block_device_t* device, block_request_t* requests) {
+    for(block_request_t* request = requests; request; request = request->next) {
+        if(request->count == 0 || request->count > device->max_sectors) return -1;
+        if(request->lba + request->count > device->sectors) return -1;
+    }
+
+    block_queue_t* queue = &device->queue;
+    uint64_t now = ktime_ns();
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    while(requests) {
+        block_request_t* request = requests;
+        requests = request->next;
+
+        request->status = BLOCK_PENDING;
+        request->device = device;
+        request->deadline = now + (uint64_t)(request->write ? BLOCK_WRITE_DEADLINE_MS
+                                                            : BLOCK_READ_DEADLINE_MS) * 1000000;
+        block_queue_insert(queue, request);
+        queue->submitted++;
+    }
+    if(enabled) enable_interrupts();
+
+    block_queue_run(device);
+    return 0;
+}
+
+// İstek tamamlanana kadar bekle: tamamlanma kesmesi gelmeyecekse
+// sürücüyü yokla, gelecekse HLT ile uyu
+void block_wait(block_device_t* device, block_request_t* request) {
+    while(request->status == BLOCK_PENDING) {
+        if(!device->interrupt_driven || !interrupts_enabled) {
+            if(device->poll) device->poll(device);
+            __asm__ volatile("pause");
+            continue;
+        }
+
+        CLI();
+        if(request->status != BLOCK_PENDING) {
+            STI();
+            break;
+        }
+        __asm__ volatile("sti; hlt");
+    }
+}
+
+// Kuyruk boşalıp sürücüdeki istekler bitince aygıt önbelleğini boşalt
+int block_flush(block_device_t* device) {
+    block_queue_t* queue = &device->queue;
+
+    while(queue->sorted || queue->in_flight) {
+        if(!device->interrupt_driven || !interrupts_enabled) {
+            if(device->poll) device->poll(device);
+            __asm__ volatile("pause");
+            continue;
+        }
+
+        CLI();
+        if(!queue->sorted && !queue->in_flight) {
+            STI();
+            break;
+        }
+        __asm__ volatile("sti; hlt");
+    }
+    return device->flush ? device->flush(device) : 0;
+}
+
+static int block_transfer(block_device_t* device, uint64_t lba, uint32_t count, void* buffer, bool write) {
+    block_request_t request;
+
+    request.lba = lba;
+    request.count = count;
+    request.buffer = buffer;
+    request.write = write;
+    request.complete = NULL;
+    request.private_data = NULL;
+    request.next = NULL;
+
+    if(block_submit(device, &request) != 0) return -1;
+    block_wait(device, &request);
+    return request.status;
+}
+
+int block_read(block_device_t* device, uint64_t lba, uint32_t count, void* buffer) {
+    return block_transfer(device, lba, count, buffer, false);
+}
+
+int block_write(block_device_t* device, uint64_t lba, uint32_t count, const void* buffer) {
+    return block_transfer(device, lba, count, (void*)buffer, true);
+}
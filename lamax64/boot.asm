@@ -2,6 +2,7 @@
 [ORG 0x7C00]
 
 %include "constants.inc"
+%include "layout.inc"
 
 start:
     ; Segmentleri temizle
@@ -10,26 +11,73 @@ start:
     mov es, ax
     mov ss, ax
     mov sp, 0x7C00
+    mov [boot_drive], dl
+    
+    ; Açılış profili ve bellek haritası başlığını sıfırla, ilk zaman damgasını al
+    cld
+    mov di, BOOT_PROFILE_ADDR
+    mov cx, (BOOT_PROFILE_SIZE + E820_MAP_HEADER) / 2
+    xor ax, ax
+    rep stosw
+    mov dword [BOOT_PROFILE_ADDR], BOOT_PROFILE_MAGIC
+    mov di, BOOT_PROFILE_MARKS + BOOT_MARK_MBR_START * 8
+    call profile_mark
     
     ; Boot mesajı
     mov si, boot_msg
     call print_string
     
+    ; EDD (int 13h uzantıları) desteğini kontrol et
+    mov ah, 0x41
+    mov bx, 0x55AA
+    mov dl, [boot_drive]
+    int 0x13
+    jc .no_edd
+    cmp bx, 0xAA55
+    jne .no_edd
+    inc byte [edd_enabled]
+.no_edd:
+    
+    ; CHS geri dönüşü için sürücü geometrisi (alınamazsa 1.44 MB disket)
+    mov ah, 0x08
+    mov dl, [boot_drive]
+    push es
+    int 0x13
+    pop es
+    jc .geometry_done
+    and cx, 0x3F
+    jz .geometry_done
+    mov [sectors_per_track], cx
+    movzx dx, dh
+    inc dx
+    mov [head_count], dx
+.geometry_done:
+    
+    ; BIOS bellek haritası: girdi sayısı E820_MAP_ADDR'de, girdiler ardında.
+    ; Kernel boş RAM'i buradan öğrenir (sabit pencere yerine).
+    xor ebx, ebx
+    mov di, E820_MAP_ENTRIES
+.e820:
+    mov eax, 0xE820
+    mov ecx, E820_ENTRY_SIZE
+    mov edx, E820_SIGNATURE
+    int 0x15
+    jc .e820_done
+    add di, E820_ENTRY_SIZE
+    inc word [E820_MAP_ADDR]
+    cmp di, E820_MAP_ENTRIES + E820_MAX_ENTRIES * E820_ENTRY_SIZE
+    jae .e820_done
+    test ebx, ebx
+    jnz .e820
+.e820_done:
+    
     ; Disk okuma - disk.bin yükle
-    mov ah, 0x02        ; Disk okuma fonksiyonu
-    mov al, DISK_SECTORS ; Kaç sektör okunacak
-    mov ch, 0           ; Cylinder 0
-    mov cl, 2           ; Sector 2 (1 = boot sector)
-    mov dh, 0           ; Head 0
-    mov dl, 0x80        ; Drive 0 (ilk hard disk)
-    mov bx, DISK_LOAD_ADDR ; Bellek adresi
-    
-    int 0x13            ; BIOS disk servisi
+    mov di, BOOT_PROFILE_MARKS + BOOT_MARK_MBR_DISK * 8
+    call profile_mark
+    call read_sectors   ; dap: LBA 1'den DISK_SECTORS sektör
     jc disk_error       ; Hata kontrolü
-    
-    ; Disk yükleme başarılı mesajı
-    mov si, disk_loaded_msg
-    call print_string
+    mov di, BOOT_PROFILE_MARKS + BOOT_MARK_MBR_LOADED * 8
+    call profile_mark
     
     ; 32-bit protected mode'a geç
     cli
@@ -57,6 +105,90 @@ print_string:
 .done:
     ret
 
+; Sektör oku: dap_lba'dan read_remaining kadar sektörü dap_segment:0'a yükler.
+; EDD varsa tek pakette EDD_MAX_SECTORS'a kadar, yoksa iz sonuna kadar
+; CHS ile okur. Hatada diski sıfırlayıp yeniden dener; EDD okuması hep
+; başarısız olursa CHS'e düşer. Hata durumunda CF=1 döner (ES bozulur).
+read_sectors:
+.chunk:
+    mov di, [read_remaining]
+    test di, di         ; CF=0
+    jz .done
+    mov bp, DISK_READ_RETRIES
+.retry:
+    cmp byte [edd_enabled], 0
+    je .chs
+    
+    ; Disk adres paketi ile LBA okuma (AH=42h)
+    cmp di, EDD_MAX_SECTORS
+    jbe .edd_count
+    mov di, EDD_MAX_SECTORS
+.edd_count:
+    mov [dap_count], di
+    mov si, dap
+    mov ah, 0x42
+    jmp .call
+    
+.chs:
+    ; LBA -> CHS; okuma iz sonunu geçemez
+    mov ax, [dap_lba]
+    xor dx, dx
+    div word [sectors_per_track]    ; AX = iz, DX = iz içindeki sektör
+    mov cx, [sectors_per_track]
+    sub cx, dx
+    cmp di, cx
+    jbe .track_count
+    mov di, cx
+.track_count:
+    mov [dap_count], di
+    inc dx
+    mov cx, dx          ; CL = sektör (1 tabanlı)
+    xor dx, dx
+    div word [head_count]           ; AX = silindir, DX = kafa
+    mov dh, dl
+    mov ch, al
+    shl ah, 6
+    or cl, ah           ; Silindirin 8-9. bitleri
+    les bx, [dap_offset]
+    mov ax, di
+    mov ah, 0x02
+    
+.call:
+    mov dl, [boot_drive]
+    int 0x13
+    jnc .advance
+    
+    ; Geçici hata: sürücüyü sıfırla ve yeniden dene
+    xor ax, ax
+    mov dl, [boot_drive]
+    int 0x13
+    mov di, [read_remaining]
+    dec bp
+    jnz .retry
+    
+    ; EDD okuması başarısız: EDD'yi kapat ve CHS ile baştan dene
+    shr byte [edd_enabled], 1
+    jc .chunk
+    stc
+.done:
+    ret
+    
+.advance:
+    mov ax, [dap_count]
+    sub [read_remaining], ax
+    add [dap_lba], ax
+    adc word [dap_lba + 2], 0
+    shl ax, 5           ; sektör * 512 / 16 = segment artışı
+    add [dap_segment], ax
+    jmp .chunk
+
+; DI'deki profil yuvasına TSC yaz (EAX, EDX bozulur)
+profile_mark:
+    rdtsc
+    mov [di], eax
+    mov [di + 4], edx
+    ret
+
 ; 32-bit protected mode başlangıcı
 [BITS 32]
 init_pm:
@@ -104,11 +236,33 @@ gdt_descriptor:
 CODE_SEG equ gdt_code - gdt_start
 DATA_SEG equ gdt_data - gdt_start
 
+; Disk okuma durumu
+boot_drive db 0
+edd_enabled db 0
+sectors_per_track dw 18
+head_count dw 2
+read_remaining dw DISK_SECTORS
+
+; EDD disk adres paketi (CHS okumaları da aynı durumu kullanır).
+; İlk değerler disk.bin'i (LBA 1) DISK_LOAD_ADDR'e okur.
+dap:
+    db 0x10, 0
+dap_count dw 0
+dap_offset dw 0
+dap_segment dw DISK_LOAD_ADDR >> 4
+dap_lba dd 1, 0
+
 ; Mesajlar
-boot_msg db 'LAMAX64 Boot Loader v1.0', 13, 10, 'Loading system...', 13, 10, 0
-disk_loaded_msg db 'Disk loader initialized.', 13, 10, 0
+boot_msg db 'LAMAX64 loading...', 13, 10, 0
 disk_error_msg db 'Disk read error!', 13, 10, 0
 
+; Aşama yerleşimi (system.h boot_layout_t, BOOT_LAYOUT_ADDR)
+%if ($ - $$) > 510 - BOOT_LAYOUT_SIZE
+    %error "boot.asm: MBR kodu ve verisi yerleşim tablosuna taşıyor"
+%endif
+times 510-BOOT_LAYOUT_SIZE-($-$$) db 0
+boot_layout:
+    dd SHELL_LBA, SHELL_SECTORS, KERNEL_LBA, KERNEL_SECTORS
+
 ; Boot signature
-times 510-($-$$) db 0
 dw 0xAA55
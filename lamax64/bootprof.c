@@ -0,0 +1,34 @@
+/*
+ * LAMAX64 OS - Açılış Profili
+ * Version 1.0.0
+ *
+ * MBR'den kernel istemine kadar her aşama 0x0500'deki ortak bloğa
+ * TSC zaman damgası yazar. Disk okuma, bekleme ve konsol çıktısı
+ * süreleri de aynı blokta birikir; kernel dökümü buradan üretir.
+ */
+
+#include "system.h"
+
+#define boot_profile ((volatile boot_profile_t*)BOOT_PROFILE_ADDR)
+
+// Aşama işareti: id'nin yuvasına şimdiki TSC'yi yaz
+void boot_profile_mark(uint32_t id) {
+    if(id >= BOOT_MARK_COUNT || boot_profile->magic != BOOT_PROFILE_MAGIC) return;
+    boot_profile->marks[id] = rdtsc();
+}
+
+// Bir kategoriye geçen süreyi ekle (açılış bitince yok sayılır)
+void boot_profile_add(uint32_t category, uint64_t cycles) {
+    if(boot_profile->magic != BOOT_PROFILE_MAGIC || boot_profile->finished) return;
+
+    switch(category) {
+        case BOOT_PROFILE_DISK:    boot_profile->disk_cycles += cycles; break;
+        case BOOT_PROFILE_DELAY:   boot_profile->delay_cycles += cycles; break;
+        case BOOT_PROFILE_CONSOLE: boot_profile->console_cycles += cycles; break;
+    }
+}
+
+void boot_profile_finish() {
+    boot_profile_mark(BOOT_MARK_PROMPT);
+    boot_profile->finished = 1;
+}
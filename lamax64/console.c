@@ -0,0 +1,249 @@
+/*
+ * LAMAX64 OS - Konsol Katmanı
+ * Version 1.0.0
+ *
+ * Çıktı, kayıtlı konsol hedeflerine (sink) dağıtılır. Yerleşik VGA
+ * hedefi yazıları önce RAM'deki gölge ekrana yazar, sadece değişen
+ * satırlar 0xB8000'e kopyalanır. VGA belleğinden hiç okuma yapılmaz.
+ */
+
+#include "system.h"
+
+// VGA ekran tamponu
+volatile char* vga_buffer = (volatile char*)VGA_BUFFER;
+int cursor_x = 0, cursor_y = 0;
+
+// Gölge ekran: satırlardan oluşan halka tampon
+// console_head, canlı ekranın ilk satırının halkadaki indeksidir.
+// Varsayılan halka sadece ekran kadardır; kernel console_set_history
+// ile daha büyük bir halka vererek geçmiş (scrollback) tutar.
+static uint16_t console_default_ring[VGA_HEIGHT][VGA_WIDTH] __attribute__((aligned(4)));
+static uint16_t (*console_ring)[VGA_WIDTH] = console_default_ring;
+static int console_ring_size = VGA_HEIGHT;
+static int console_head = 0;
+
+// Halkadaki geçerli satır sayısı (ekran + geçmiş)
+static int console_lines = VGA_HEIGHT;
+
+// Görünüm: canlı ekrandan kaç satır geride (0 = canlı)
+static int console_view = 0;
+
+// Kirli satır maskesi (bit n = ekran satırı n)
+static uint32_t console_dirty = 0;
+
+// Varsayılan yazı rengi
+static uint8_t console_color = 0x07;
+
+#define CONSOLE_ALL_DIRTY   ((1u << VGA_HEIGHT) - 1)
+
+static void vga_sink_write(const char* buffer, int length, uint8_t color);
+static void vga_sink_flush();
+
+// Yerleşik VGA hedefi
+static console_sink_t vga_sink = {
+    "vga", CONSOLE_SINK_VGA, true, vga_sink_write, vga_sink_flush, NULL
+};
+
+// Kayıtlı hedefler listesi
+static console_sink_t* console_sinks = &vga_sink;
+
+// Canlı ekran satırından (negatif = geçmiş) halka satırına
+static inline uint16_t* console_row(int row) {
+    int index = console_head + row;
+    if(index >= console_ring_size) index -= console_ring_size;
+    else if(index < 0) index += console_ring_size;
+    return console_ring[index];
+}
+
+// Bir satırı boşluklarla doldur
+static void console_clear_row(int row) {
+    uint16_t blank = make_vga_entry(' ', console_color);
+    uint16_t* cell = console_row(row);
+    for(int i = 0; i < VGA_WIDTH; i++) {
+        cell[i] = blank;
+    }
+    console_dirty |= 1u << row;
+}
+
+// Kaydırma O(1): başı ilerlet, yeni son satırı temizle.
+// Ekrandan çıkan satır halkada kalır, geçmiş için ek maliyet yoktur.
+// Ekran bir sonraki flush'ta halkadan tek geçişte yeniden çizilir.
+static void console_scroll() {
+    if(++console_head == console_ring_size) console_head = 0;
+    if(console_lines < console_ring_size) console_lines++;
+    console_clear_row(VGA_HEIGHT - 1);
+    console_dirty = CONSOLE_ALL_DIRTY;
+}
+
+// Bir halka satırını VGA belleğine 32-bit yazmalarla kopyala
+static void console_draw_row(int screen_row, const uint16_t* cells) {
+    volatile uint32_t* dst = (volatile uint32_t*)vga_buffer + screen_row * (VGA_WIDTH / 2);
+    const uint32_t* src = (const uint32_t*)cells;
+    for(int i = 0; i < VGA_WIDTH / 2; i++) {
+        dst[i] = src[i];
+    }
+}
+
+// Konsolu başlat ve ekranı temizle
+void console_init(uint8_t color) {
+    console_color = color;
+    console_clear();
+}
+
+void console_set_color(uint8_t color) {
+    console_color = color;
+}
+
+// Geçmiş tamponu ver: rows satırlık halka (en az VGA_HEIGHT).
+// Mevcut ekran içeriği yeni halkaya taşınır.
+void console_set_history(uint16_t (*rows)[VGA_WIDTH], int count) {
+    if(count < VGA_HEIGHT) return;
+
+    for(int row = 0; row < VGA_HEIGHT; row++) {
+        const uint32_t* src = (const uint32_t*)console_row(row);
+        uint32_t* dst = (uint32_t*)rows[row];
+        for(int i = 0; i < VGA_WIDTH / 2; i++) {
+            dst[i] = src[i];
+        }
+    }
+    console_ring = rows;
+    console_ring_size = count;
+    console_head = 0;
+    console_lines = VGA_HEIGHT;
+    console_view = 0;
+}
+
+// Görünümü kaydır (pozitif = geçmişe doğru). Sadece görünüm
+// gerçekten değişirse ekran yeniden çizilir.
+void console_scroll_view(int lines) {
+    int view = console_view + lines;
+    int max_view = console_lines - VGA_HEIGHT;
+
+    if(view > max_view) view = max_view;
+    if(view < 0) view = 0;
+    if(view == console_view) return;
+
+    console_view = view;
+    for(int row = 0; row < VGA_HEIGHT; row++) {
+        console_draw_row(row, console_row(row - view));
+    }
+}
+
+void console_page_up() {
+    console_scroll_view(VGA_HEIGHT - 1);
+}
+
+void console_page_down() {
+    console_scroll_view(-(VGA_HEIGHT - 1));
+}
+
+// Ekranı temizle (geçmiş korunur)
+void console_clear() {
+    for(int row = 0; row < VGA_HEIGHT; row++) {
+        console_clear_row(row);
+    }
+    cursor_x = 0; cursor_y = 0;
+    vga_sink_flush();
+}
+
+// Tek karakteri gölge ekrana yaz (VGA'ya dokunmaz)
+static void vga_putc(char c, uint8_t color) {
+    if(c == '\n') {
+        cursor_x = 0; cursor_y++;
+    } else {
+        console_row(cursor_y)[cursor_x] = make_vga_entry(c, color);
+        console_dirty |= 1u << cursor_y;
+        cursor_x++;
+    }
+    if(cursor_x >= VGA_WIDTH) { cursor_x = 0; cursor_y++; }
+    if(cursor_y >= VGA_HEIGHT) {
+        cursor_y = VGA_HEIGHT - 1;
+        console_scroll();
+    }
+}
+
+static void vga_sink_write(const char* buffer, int length, uint8_t color) {
+    for(int i = 0; i < length; i++) {
+        vga_putc(buffer[i], color);
+    }
+}
+
+// Kirli satırları VGA belleğine aktar
+static void vga_sink_flush() {
+    uint32_t dirty = console_dirty;
+    if(!dirty) return;
+
+    // Yeni çıktı gelince görünüm canlı ekrana döner
+    if(console_view) {
+        console_view = 0;
+        dirty = CONSOLE_ALL_DIRTY;
+    }
+
+    for(int row = 0; dirty; row++, dirty >>= 1) {
+        if(dirty & 1) console_draw_row(row, console_row(row));
+    }
+    console_dirty = 0;
+}
+
+// Yeni bir konsol hedefi ekle
+void console_register_sink(console_sink_t* sink) {
+    sink->next = console_sinks;
+    console_sinks = sink;
+}
+
+// Etkin hedefleri seç (CONSOLE_SINK_* bit maskesi)
+void console_select_sinks(uint32_t mask) {
+    for(console_sink_t* sink = console_sinks; sink; sink = sink->next) {
+        sink->enabled = (mask & sink->id) != 0;
+    }
+}
+
+// Uzunluğu bilinen tamponu tüm etkin hedeflere yaz (flush etmez)
+void console_write_colored(const char* buffer, int length, uint8_t color) {
+    uint64_t start = rdtsc();
+    for(console_sink_t* sink = console_sinks; sink; sink = sink->next) {
+        if(sink->enabled) sink->write(buffer, length, color);
+    }
+    boot_profile_add(BOOT_PROFILE_CONSOLE, rdtsc() - start);
+}
+
+void console_write(const char* buffer, int length) {
+    console_write_colored(buffer, length, console_color);
+}
+
+void console_putc(char c, uint8_t color) {
+    console_write_colored(&c, 1, color);
+}
+
+void console_flush() {
+    uint64_t start = rdtsc();
+    for(console_sink_t* sink = console_sinks; sink; sink = sink->next) {
+        if(sink->enabled && sink->flush) sink->flush();
+    }
+    boot_profile_add(BOOT_PROFILE_CONSOLE, rdtsc() - start);
+}
+
+// İmlecin solundaki karakteri sil (satır düzenleyici için)
+void console_backspace() {
+    if(cursor_x == 0) return;
+
+    cursor_x--;
+    console_row(cursor_y)[cursor_x] = make_vga_entry(' ', console_color);
+    console_dirty |= 1u << cursor_y;
+    for(console_sink_t* sink = console_sinks; sink; sink = sink->next) {
+        if(sink->enabled && sink != &vga_sink) sink->write("\b \b", 3, console_color);
+    }
+    console_flush();
+}
+
+// Basit ekran çıktısı
+void kprint(const char* str) {
+    kprint_colored(str, console_color);
+}
+
+void kprint_colored(const char* str, uint8_t color) {
+    int length = 0;
+    while(str[length]) length++;
+    console_write_colored(str, length, color);
+    console_flush();
+}
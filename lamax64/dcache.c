@@ -0,0 +1,179 @@
+/*
+ * LAMAX64 OS - Dizin Girdisi Önbelleği (dcache)
+ * Version 1.0.0
+ *
+ * Yol çözümünde her bileşen (bağlama, üst dizin id'si, ad) anahtarıyla
+ * burada aranır; isabet dosya sisteminin lookup işlevini ve dizin blok
+ * okumalarını tümden atlar. Bulunamayan adlar negatif girdi olarak
+ * saklanır, böylece olmayan dosyanın tekrar tekrar aranması da bellekten
+ * yanıtlanır. Girdiler sabit bir havuzdadır; yer gerektiğinde en uzun
+ * süredir kullanılmayan (LRU) sabitlenmemiş girdi geri alınır.
+ */
+
+#include "system.h"
+
+static dentry_t dcache_entries[DCACHE_ENTRIES];
+static dentry_t* dcache_hash[DCACHE_HASH_SIZE];
+
+// lru_head en son kullanılan, lru_tail geri alma adayı
+static dentry_t* lru_head = NULL;
+static dentry_t* lru_tail = NULL;
+
+static dcache_stats_t dcache_stats;
+
+static uint32_t dcache_name_hash(vfs_mount_t* mount, uint64_t parent, const char* name) {
+    uint32_t hash = 2166136261u ^ (uint32_t)(uintptr_t)mount ^ (uint32_t)parent ^ (uint32_t)(parent >> 32);
+    while(*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline uint32_t dcache_bucket(uint32_t hash) {
+    return (hash * 2654435761u) >> (32 - DCACHE_HASH_BITS);
+}
+
+static void lru_unlink(dentry_t* dentry) {
+    if(dentry->lru_prev) dentry->lru_prev->lru_next = dentry->lru_next;
+    else lru_head = dentry->lru_next;
+    if(dentry->lru_next) dentry->lru_next->lru_prev = dentry->lru_prev;
+    else lru_tail = dentry->lru_prev;
+}
+
+static void lru_push_front(dentry_t* dentry) {
+    dentry->lru_prev = NULL;
+    dentry->lru_next = lru_head;
+    if(lru_head) lru_head->lru_prev = dentry;
+    else lru_tail = dentry;
+    lru_head = dentry;
+}
+
+static void lru_push_back(dentry_t* dentry) {
+    dentry->lru_next = NULL;
+    dentry->lru_prev = lru_tail;
+    if(lru_tail) lru_tail->lru_next = dentry;
+    else lru_head = dentry;
+    lru_tail = dentry;
+}
+
+static void dcache_unhash(dentry_t* dentry) {
+    if(!dentry->hashed) return;
+
+    dentry_t** link = &dcache_hash[dcache_bucket(dentry->hash)];
+    while(*link && *link != dentry) link = &(*link)->hash_next;
+    if(*link) *link = dentry->hash_next;
+    dentry->hash_next = NULL;
+    dentry->hashed = false;
+    dcache_stats.entries--;
+}
+
+// Karmadan çıkan ve sabitlenmemiş girdi boşa döner, LRU'nun sonuna gider
+static void dcache_release_entry(dentry_t* dentry) {
+    dcache_unhash(dentry);
+    if(dentry->refcount) return;
+
+    dentry->mount = NULL;
+    lru_unlink(dentry);
+    lru_push_back(dentry);
+}
+
+static dentry_t* dcache_find(vfs_mount_t* mount, uint64_t parent, const char* name, uint32_t hash) {
+    dentry_t* dentry = dcache_hash[dcache_bucket(hash)];
+    while(dentry) {
+        if(dentry->hash == hash && dentry->mount == mount && dentry->parent == parent &&
+           strcmp(dentry->name, name) == 0) {
+            return dentry;
+        }
+        dentry = dentry->hash_next;
+    }
+    return NULL;
+}
+
+dentry_t* dcache_lookup(vfs_mount_t* mount, uint64_t parent, const char* name) {
+    dentry_t* dentry = dcache_find(mount, parent, name, dcache_name_hash(mount, parent, name));
+    if(!dentry) {
+        dcache_stats.misses++;
+        return NULL;
+    }
+
+    if(dentry->negative) dcache_stats.negative_hits++;
+    else dcache_stats.hits++;
+    lru_unlink(dentry);
+    lru_push_front(dentry);
+    return dentry;
+}
+
+// Aynı anahtarlı girdinin yerini alır; node NULL ise negatif girdi.
+// Tüm girdiler sabitliyse NULL döner (önbelleğe alınmaz).
+dentry_t* dcache_add(vfs_mount_t* mount, uint64_t parent, const char* name, const vfs_node_t* node) {
+    if(strlen(name) >= MAX_FILENAME) return NULL;
+
+    uint32_t hash = dcache_name_hash(mount, parent, name);
+    dentry_t* old = dcache_find(mount, parent, name, hash);
+    if(old) dcache_release_entry(old);
+
+    dentry_t* dentry = lru_tail;
+    while(dentry && dentry->refcount) dentry = dentry->lru_prev;
+    if(!dentry) return NULL;
+
+    if(dentry->mount) {
+        dcache_unhash(dentry);
+        dcache_stats.evictions++;
+    }
+
+    dentry->mount = mount;
+    dentry->parent = parent;
+    dentry->hash = hash;
+    strcpy(dentry->name, name);
+    dentry->negative = node == NULL;
+    if(node) dentry->node = *node;
+
+    uint32_t bucket = dcache_bucket(hash);
+    dentry->hash_next = dcache_hash[bucket];
+    dcache_hash[bucket] = dentry;
+    dentry->hashed = true;
+    dcache_stats.entries++;
+
+    lru_unlink(dentry);
+    lru_push_front(dentry);
+    return dentry;
+}
+
+// Silinen dizinin altındaki girdileri at: dizinin id'si yeniden kullanılabilir
+void dcache_invalidate_dir(vfs_mount_t* mount, uint64_t dir) {
+    for(int i = 0; i < DCACHE_ENTRIES; i++) {
+        dentry_t* dentry = &dcache_entries[i];
+        if(dentry->hashed && dentry->mount == mount && dentry->parent == dir) dcache_release_entry(dentry);
+    }
+}
+
+void dcache_get(dentry_t* dentry) {
+    if(dentry) dentry->refcount++;
+}
+
+void dcache_put(dentry_t* dentry) {
+    if(!dentry || dentry->refcount == 0) return;
+    if(--dentry->refcount == 0 && !dentry->hashed) dcache_release_entry(dentry);
+}
+
+void dcache_get_stats(dcache_stats_t* stats) {
+    *stats = dcache_stats;
+}
+
+void dcache_init() {
+    lru_head = NULL;
+    lru_tail = NULL;
+    for(int i = 0; i < DCACHE_HASH_SIZE; i++) dcache_hash[i] = NULL;
+
+    for(int i = 0; i < DCACHE_ENTRIES; i++) {
+        dentry_t* dentry = &dcache_entries[i];
+        dentry->mount = NULL;
+        dentry->hashed = false;
+        dentry->refcount = 0;
+        dentry->hash_next = NULL;
+        lru_push_front(dentry);
+    }
+
+    dcache_stats = (dcache_stats_t){0};
+}
@@ -4,52 +4,19 @@
  */
 
 #include "system.h"
+#include "ata.h"
 
-// VGA ekran tamponu
-volatile char* vga_buffer = (volatile char*)0xB8000;
-int cursor_x = 0, cursor_y = 0;
+// Açılış diski (birincil IDE kanalı, master)
+static ata_device_t boot_disk;
+static const boot_layout_t* boot_layout = (const boot_layout_t*)BOOT_LAYOUT_ADDR;
 
-// Basit printf benzeri fonksiyon
-void kprint(const char* str) {
-    while(*str) {
-        if(*str == '\n') {
-            cursor_x = 0;
-            cursor_y++;
-        } else {
-            int index = (cursor_y * 80 + cursor_x) * 2;
-            vga_buffer[index] = *str;
-            vga_buffer[index + 1] = 0x07; // Beyaz yazı, siyah arkaplan
-            cursor_x++;
-        }
-        str++;
-        
-        if(cursor_x >= 80) {
-            cursor_x = 0;
-            cursor_y++;
-        }
-        
-        if(cursor_y >= 25) {
-            cursor_y = 24;
-            // Ekranı kaydır (basit implementasyon)
-            for(int i = 0; i < 24 * 80; i++) {
-                vga_buffer[i * 2] = vga_buffer[(i + 80) * 2];
-                vga_buffer[i * 2 + 1] = vga_buffer[(i + 80) * 2 + 1];
-            }
-            // Son satırı temizle
-            for(int i = 24 * 80; i < 25 * 80; i++) {
-                vga_buffer[i * 2] = ' ';
-                vga_buffer[i * 2 + 1] = 0x07;
-            }
-        }
-    }
-}
-
-// Basit disk okuma fonksiyonu (gerçek implementasyon BIOS int 13h kullanır)
+// Korumalı modda BIOS yok: sektörleri ATA PIO ile oku
 int read_disk_sectors(int sector, int count, void* buffer) {
-    // Bu gerçek bir implementasyonda assembly ile BIOS çağrısı yapılır
-    // Şimdilik simülasyon amaçlı
-    kprint("Reading sectors from disk...\n");
-    return 0; // Başarı
+    uint64_t start = rdtsc();
+    int result = ata_read(&boot_disk, sector, count, buffer);
+
+    boot_profile_add(BOOT_PROFILE_DISK, rdtsc() - start);
+    return result;
 }
 
 // Shell.bin'i yükle ve çalıştır
@@ -57,32 +24,35 @@ void load_shell() {
     kprint("LAMAX64 Disk Loader v1.0.0\n");
     kprint("Loading shell.bin...\n");
     
+    if(!ata_init(&boot_disk, ATA_PRIMARY_IO, ATA_PRIMARY_CTRL, false)) {
+        kprint("ERROR: No ATA boot disk found!\n");
+        while(1) {} // Sistem durdur
+    }
+    
     // Shell.bin'i belirli sektörlerden oku
-    char* shell_buffer = (char*)0x9000;
+    char* shell_buffer = (char*)SHELL_LOAD_ADDR;
     
-    if(read_disk_sectors(6, 8, shell_buffer) != 0) {
+    if(read_disk_sectors(boot_layout->shell_lba, boot_layout->shell_sectors, shell_buffer) != 0) {
         kprint("ERROR: Failed to load shell.bin!\n");
         while(1) {} // Sistem durdur
     }
     
+    boot_profile_mark(BOOT_MARK_SHELL_LOADED);
     kprint("Shell loaded successfully!\n");
     kprint("Transferring control to shell...\n\n");
     
     // Shell'e geç (function pointer olarak çağır)
-    void (*shell_entry)() = (void(*)())0x9000;
+    void (*shell_entry)() = (void(*)())SHELL_LOAD_ADDR;
     shell_entry();
 }
 
-// Ana entry point
+// Ana entry point (disk.ld bunu 0x8000'e, imajın başına koyar)
+__attribute__((section(".text.entry")))
 void disk_main() {
-    // Ekranı temizle
-    for(int i = 0; i < 80 * 25; i++) {
-        vga_buffer[i * 2] = ' ';
-        vga_buffer[i * 2 + 1] = 0x07;
-    }
-    
-    cursor_x = 0;
-    cursor_y = 0;
+    boot_profile_mark(BOOT_MARK_DISK_MAIN);
+
+    // Konsolu başlat ve ekranı temizle
+    console_init(0x07);
     
     load_shell();
     
@@ -0,0 +1,156 @@
+/*
+ * LAMAX64 OS - ACPI Tabloları
+ * Version 1.0.0
+ *
+ * RSDP/RSDT/XSDT üzerinden tablo bulma ve MADT'den IO-APIC ve
+ * kesme yönlendirme (interrupt override) bilgilerinin okunması.
+ */
+
+#include "system.h"
+#include "acpi.h"
+
+// BIOS veri alanında EBDA segment adresi
+#define BDA_EBDA_SEGMENT    0x40E
+
+static acpi_rsdp_t* acpi_rsdp = NULL;
+static acpi_rsdt_t* acpi_rsdt = NULL;
+static acpi_xsdt_t* acpi_xsdt = NULL;
+static acpi_madt_t* acpi_madt = NULL;
+
+static bool acpi_checksum(const void* table, uint32_t length) {
+    const uint8_t* bytes = (const uint8_t*)table;
+    uint8_t sum = 0;
+    for(uint32_t i = 0; i < length; i++) sum += bytes[i];
+    return sum == 0;
+}
+
+static bool acpi_signature_equal(const char* a, const char* b, int length) {
+    for(int i = 0; i < length; i++) {
+        if(a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+// 16 bayt hizalı "RSD PTR " imzasını ara
+static acpi_rsdp_t* acpi_scan_rsdp(uint32_t start, uint32_t length) {
+    for(uint32_t addr = start; addr < start + length; addr += 16) {
+        acpi_rsdp_t* rsdp = (acpi_rsdp_t*)(uintptr_t)addr;
+        if(acpi_signature_equal(rsdp->signature, "RSD PTR ", 8) &&
+           acpi_checksum(rsdp, 20)) {
+            return rsdp;
+        }
+    }
+    return NULL;
+}
+
+acpi_rsdp_t* acpi_find_rsdp(void) {
+    uint32_t ebda = (uint32_t)(*(volatile uint16_t*)BDA_EBDA_SEGMENT) << 4;
+    acpi_rsdp_t* rsdp = NULL;
+
+    if(ebda) rsdp = acpi_scan_rsdp(ebda, 1024);
+    if(!rsdp) rsdp = acpi_scan_rsdp(0xE0000, 0x20000);
+    return rsdp;
+}
+
+bool acpi_init(void) {
+    if(acpi_rsdp) return true;
+
+    acpi_rsdp = acpi_find_rsdp();
+    if(!acpi_rsdp) return false;
+
+    // XSDT sadece 4GB altındaysa kullanılabilir (sayfalama yok)
+    if(acpi_rsdp->revision >= 2 && acpi_rsdp->xsdt_address &&
+       acpi_rsdp->xsdt_address < 0x100000000ULL) {
+        acpi_xsdt = (acpi_xsdt_t*)(uintptr_t)acpi_rsdp->xsdt_address;
+    } else {
+        acpi_rsdt = (acpi_rsdt_t*)(uintptr_t)acpi_rsdp->rsdt_address;
+    }
+    acpi_madt = (acpi_madt_t*)acpi_find_table("APIC", 0);
+    return true;
+}
+
+// İmzası eşleşen index'inci tabloyu bul
+void* acpi_find_table(const char* signature, uint32_t index) {
+    void* root_table = acpi_xsdt ? (void*)acpi_xsdt : (void*)acpi_rsdt;
+    acpi_table_header_t* root = (acpi_table_header_t*)root_table;
+    if(!root) return NULL;
+
+    uint32_t entry_size = acpi_xsdt ? 8 : 4;
+    uint32_t count = (root->length - sizeof(acpi_table_header_t)) / entry_size;
+
+    for(uint32_t i = 0; i < count; i++) {
+        uint64_t addr = acpi_xsdt ? acpi_xsdt->entries[i] : acpi_rsdt->entries[i];
+        if(addr >= 0x100000000ULL) continue;
+
+        acpi_table_header_t* table = (acpi_table_header_t*)(uintptr_t)addr;
+        if(!acpi_signature_equal(table->signature, signature, 4)) continue;
+        if(!acpi_checksum(table, table->length)) continue;
+        if(index-- == 0) return table;
+    }
+    return NULL;
+}
+
+acpi_madt_t* acpi_get_madt(void) {
+    return acpi_madt;
+}
+
+acpi_hpet_t* acpi_get_hpet(void) {
+    return (acpi_hpet_t*)acpi_find_table("HPET", 0);
+}
+
+acpi_mcfg_t* acpi_get_mcfg(void) {
+    return (acpi_mcfg_t*)acpi_find_table("MCFG", 0);
+}
+
+// MADT'de verilen tipteki index'inci girişi bul
+static acpi_madt_entry_header_t* acpi_madt_entry(uint8_t type, uint32_t index) {
+    if(!acpi_madt) return NULL;
+
+    uint8_t* entry = acpi_madt->entries;
+    uint8_t* end = (uint8_t*)acpi_madt + acpi_madt->header.length;
+
+    while(entry + sizeof(acpi_madt_entry_header_t) <= end) {
+        acpi_madt_entry_header_t* header = (acpi_madt_entry_header_t*)entry;
+        if(header->length == 0) break;
+        if(header->type == type && index-- == 0) return header;
+        entry += header->length;
+    }
+    return NULL;
+}
+
+static uint32_t acpi_madt_count(uint8_t type) {
+    uint32_t count = 0;
+    while(acpi_madt_entry(type, count)) count++;
+    return count;
+}
+
+uint32_t acpi_get_io_apic_count(void) {
+    return acpi_madt_count(ACPI_MADT_IO_APIC);
+}
+
+uint32_t acpi_get_io_apic_address(uint32_t index) {
+    acpi_madt_io_apic_t* io_apic = (acpi_madt_io_apic_t*)acpi_madt_entry(ACPI_MADT_IO_APIC, index);
+    return io_apic ? io_apic->io_apic_address : 0;
+}
+
+uint32_t acpi_get_io_apic_gsib(uint32_t index) {
+    acpi_madt_io_apic_t* io_apic = (acpi_madt_io_apic_t*)acpi_madt_entry(ACPI_MADT_IO_APIC, index);
+    return io_apic ? io_apic->global_system_interrupt_base : 0;
+}
+
+uint32_t acpi_get_interrupt_override_count(void) {
+    return acpi_madt_count(ACPI_MADT_INTERRUPT_OVERRIDE);
+}
+
+bool acpi_get_interrupt_override(uint32_t index, uint8_t *bus, uint8_t *source,
+                                 uint32_t *global_interrupt, uint16_t *flags) {
+    acpi_madt_interrupt_override_t* override =
+        (acpi_madt_interrupt_override_t*)acpi_madt_entry(ACPI_MADT_INTERRUPT_OVERRIDE, index);
+    if(!override) return false;
+
+    if(bus) *bus = override->bus;
+    if(source) *source = override->source;
+    if(global_interrupt) *global_interrupt = override->global_system_interrupt;
+    if(flags) *flags = override->flags;
+    return true;
+}
@@ -0,0 +1,285 @@
+/*
+ * LAMAX64 OS - ATA Disk Sürücüsü
+ * Version 1.0.0
+ *
+ * IDE kanalındaki diskler için LBA28/LBA48 çok sektörlü PIO
+ * (rep insw/outsw) ve bus-master DMA. BIOS'a ihtiyaç duymadığı için
+ * disk yükleyici, shell ve kernel aynı kodu kullanır; DMA sadece
+ * kernel PCI denetleyicisini bulup ata_enable_dma çağırınca açılır.
+ */
+
+#include "system.h"
+#include "ata.h"
+
+// Görev dosyası yazmaçları (io_base + n)
+#define ATA_REG_DATA        0
+#define ATA_REG_ERROR       1
+#define ATA_REG_COUNT       2
+#define ATA_REG_LBA0        3
+#define ATA_REG_LBA1        4
+#define ATA_REG_LBA2        5
+#define ATA_REG_DRIVE       6
+#define ATA_REG_STATUS      7
+#define ATA_REG_COMMAND     7
+
+// Durum bitleri
+#define ATA_SR_ERR          0x01
+#define ATA_SR_DRQ          0x08
+#define ATA_SR_DF           0x20
+#define ATA_SR_BSY          0x80
+
+// Komutlar
+#define ATA_CMD_READ_PIO        0x20
+#define ATA_CMD_READ_PIO_EXT    0x24
+#define ATA_CMD_READ_DMA_EXT    0x25
+#define ATA_CMD_WRITE_PIO       0x30
+#define ATA_CMD_WRITE_PIO_EXT   0x34
+#define ATA_CMD_WRITE_DMA_EXT   0x35
+#define ATA_CMD_READ_DMA        0xC8
+#define ATA_CMD_WRITE_DMA       0xCA
+#define ATA_CMD_FLUSH           0xE7
+#define ATA_CMD_FLUSH_EXT       0xEA
+#define ATA_CMD_IDENTIFY        0xEC
+
+// Bus-master yazmaçları (bmide_base + n)
+#define BM_COMMAND          0
+#define BM_STATUS           2
+#define BM_PRDT             4
+#define BM_CMD_START        0x01
+#define BM_CMD_READ         0x08    // Diskten belleğe
+#define BM_SR_ACTIVE        0x01
+#define BM_SR_ERROR         0x02
+#define BM_SR_IRQ           0x04
+
+#define ATA_LBA28_MAX       0x0FFFFFFF
+#define ATA_PRD_EOT         0x8000
+
+// Durum yazmacı yoklama sınırı (zamanlayıcı olmayan aşamalarda da çalışır)
+#define ATA_TIMEOUT         1000000
+
+// 256 bayt hizalı tablo 64 KB sınırını geçemez
+static ata_prd_t ata_prd_table[ATA_PRD_ENTRIES] __attribute__((aligned(256)));
+
+// 400 ns bekleme: alternatif durum yazmacını dört kez oku
+static void ata_delay(ata_device_t *device) {
+    for(int i = 0; i < 4; i++) inb(device->ctrl_base);
+}
+
+// BSY düşene kadar bekle; drq ise veri hazır olana kadar da bekle
+static int ata_wait(ata_device_t *device, bool drq) {
+    for(uint32_t i = 0; i < ATA_TIMEOUT; i++) {
+        uint8_t status = inb(device->io_base + ATA_REG_STATUS);
+        if(status & ATA_SR_BSY) continue;
+        if(status & (ATA_SR_ERR | ATA_SR_DF)) return -1;
+        if(!drq || (status & ATA_SR_DRQ)) return 0;
+    }
+    return -1;
+}
+
+// Sürücüyü seç, sektör sayısı ve LBA'yı yaz (LBA48'de önce yüksek baytlar)
+static void ata_setup(ata_device_t *device, uint64_t lba, uint32_t count, bool lba48) {
+    uint16_t io = device->io_base;
+
+    if(lba48) {
+        outb(io + ATA_REG_DRIVE, 0x40 | (device->slave << 4));
+        ata_delay(device);
+        outb(io + ATA_REG_COUNT, (count >> 8) & 0xFF);
+        outb(io + ATA_REG_LBA0, (lba >> 24) & 0xFF);
+        outb(io + ATA_REG_LBA1, (lba >> 32) & 0xFF);
+        outb(io + ATA_REG_LBA2, (lba >> 40) & 0xFF);
+    } else {
+        outb(io + ATA_REG_DRIVE, 0xE0 | (device->slave << 4) | ((lba >> 24) & 0x0F));
+        ata_delay(device);
+    }
+    outb(io + ATA_REG_COUNT, count & 0xFF);
+    outb(io + ATA_REG_LBA0, lba & 0xFF);
+    outb(io + ATA_REG_LBA1, (lba >> 8) & 0xFF);
+    outb(io + ATA_REG_LBA2, (lba >> 16) & 0xFF);
+}
+
+// Tek komutla count sektör: her sektör için DRQ bekle, 256 kelime aktar
+static int ata_pio(ata_device_t *device, uint64_t lba, uint32_t count, uint8_t *buffer,
+                   bool write, bool lba48) {
+    uint16_t io = device->io_base;
+
+    if(ata_wait(device, false) != 0) return -1;
+    ata_setup(device, lba, count, lba48);
+    if(write) outb(io + ATA_REG_COMMAND, lba48 ? ATA_CMD_WRITE_PIO_EXT : ATA_CMD_WRITE_PIO);
+    else outb(io + ATA_REG_COMMAND, lba48 ? ATA_CMD_READ_PIO_EXT : ATA_CMD_READ_PIO);
+
+    for(uint32_t i = 0; i < count; i++) {
+        ata_delay(device);
+        if(ata_wait(device, true) != 0) return -1;
+
+        if(write) outsw(io + ATA_REG_DATA, buffer, ATA_SECTOR_SIZE / 2);
+        else insw(io + ATA_REG_DATA, buffer, ATA_SECTOR_SIZE / 2);
+        buffer += ATA_SECTOR_SIZE;
+    }
+    return write ? ata_wait(device, false) : 0;
+}
+
+// PRD tablosunu doldur: hiçbir bölge 64 KB sınırını geçemez
+static bool ata_build_prd(uint32_t address, uint32_t bytes) {
+    int entry = 0;
+
+    while(bytes) {
+        if(entry == ATA_PRD_ENTRIES) return false;
+
+        uint32_t chunk = 0x10000 - (address & 0xFFFF);
+        if(chunk > bytes) chunk = bytes;
+
+        ata_prd_table[entry].address = address;
+        ata_prd_table[entry].byte_count = chunk & 0xFFFF;
+        ata_prd_table[entry].flags = 0;
+        address += chunk;
+        bytes -= chunk;
+        entry++;
+    }
+    ata_prd_table[entry - 1].flags = ATA_PRD_EOT;
+    return true;
+}
+
+// Bus-master DMA: denetleyici PRD tablosundaki bölgeleri kendisi doldurur
+static int ata_dma(ata_device_t *device, uint64_t lba, uint32_t count, uint8_t *buffer,
+                   bool write, bool lba48) {
+    uint16_t io = device->io_base;
+    uint16_t bm = device->bmide_base;
+    uint8_t direction = write ? 0 : BM_CMD_READ;
+    int result = -1;
+
+    if(!ata_build_prd((uintptr_t)buffer, count * ATA_SECTOR_SIZE)) return -1;
+    if(ata_wait(device, false) != 0) return -1;
+
+    outl(bm + BM_PRDT, (uintptr_t)ata_prd_table);
+    outb(bm + BM_COMMAND, direction);
+    outb(bm + BM_STATUS, inb(bm + BM_STATUS) | BM_SR_ERROR | BM_SR_IRQ);
+
+    ata_setup(device, lba, count, lba48);
+    if(write) outb(io + ATA_REG_COMMAND, lba48 ? ATA_CMD_WRITE_DMA_EXT : ATA_CMD_WRITE_DMA);
+    else outb(io + ATA_REG_COMMAND, lba48 ? ATA_CMD_READ_DMA_EXT : ATA_CMD_READ_DMA);
+    outb(bm + BM_COMMAND, direction | BM_CMD_START);
+
+    for(uint32_t i = 0; i < ATA_TIMEOUT; i++) {
+        uint8_t status = inb(bm + BM_STATUS);
+        if(status & BM_SR_ERROR) break;
+        if((status & BM_SR_IRQ) || !(status & BM_SR_ACTIVE)) {
+            result = 0;
+            break;
+        }
+    }
+
+    outb(bm + BM_COMMAND, direction);
+    outb(bm + BM_STATUS, BM_SR_ERROR | BM_SR_IRQ);
+    if(result == 0) result = ata_wait(device, false);
+    return result;
+}
+
+static int ata_transfer(ata_device_t *device, uint64_t lba, uint32_t count, uint8_t *buffer,
+                        bool write) {
+    if(!device->present || lba + count > device->sectors) return -1;
+
+    while(count) {
+        // Büyük, hizalı ve 4 GB altındaki aktarımlar DMA ile, kalanlar PIO ile
+        bool dma = device->dma && count >= ATA_DMA_MIN_SECTORS && !((uintptr_t)buffer & 1) &&
+                   (uint64_t)(uintptr_t)buffer + (uint64_t)count * ATA_SECTOR_SIZE <= ATA_DMA_LIMIT;
+        uint32_t max = dma && device->lba48 ? ATA_DMA_MAX_SECTORS : ATA_PIO_MAX_SECTORS;
+        uint32_t chunk = count < max ? count : max;
+
+        bool lba48 = chunk > ATA_PIO_MAX_SECTORS || lba + chunk > ATA_LBA28_MAX;
+        if(lba48 && !device->lba48) return -1;
+
+        int result = dma ? ata_dma(device, lba, chunk, buffer, write, lba48)
+                         : ata_pio(device, lba, chunk, buffer, write, lba48);
+        if(result != 0) return -1;
+
+        lba += chunk;
+        count -= chunk;
+        buffer += chunk * ATA_SECTOR_SIZE;
+    }
+    return 0;
+}
+
+int ata_read(ata_device_t *device, uint64_t lba, uint32_t count, void *buffer) {
+    return ata_transfer(device, lba, count, (uint8_t*)buffer, false);
+}
+
+// Sürücü önbelleğini boşaltmaz; kalıcılık için ata_flush (block katmanında
+// device->flush) ayrıca çağrılır
+int ata_write(ata_device_t *device, uint64_t lba, uint32_t count, const void *buffer) {
+    return ata_transfer(device, lba, count, (uint8_t*)buffer, true);
+}
+
+// Diskin yazma önbelleğini boşalt
+int ata_flush(ata_device_t *device) {
+    if(!device->present || ata_wait(device, false) != 0) return -1;
+
+    outb(device->io_base + ATA_REG_DRIVE, 0xE0 | (device->slave << 4));
+    ata_delay(device);
+    outb(device->io_base + ATA_REG_COMMAND, device->lba48 ? ATA_CMD_FLUSH_EXT : ATA_CMD_FLUSH);
+    ata_delay(device);
+    return ata_wait(device, false);
+}
+
+// IDENTIFY ile diski tanı; ATAPI ve boş kanal için false döner
+bool ata_init(ata_device_t *device, uint16_t io_base, uint16_t ctrl_base, bool slave) {
+    uint16_t identify[256];
+    uint16_t io = io_base;
+
+    device->io_base = io_base;
+    device->ctrl_base = ctrl_base;
+    device->bmide_base = 0;
+    device->slave = slave;
+    device->present = false;
+    device->dma = false;
+
+    // Boş veriyolu 0xFF okur
+    if(inb(io + ATA_REG_STATUS) == 0xFF) return false;
+    outb(ctrl_base, 0);                 // nIEN=0, SRST=0
+
+    outb(io + ATA_REG_DRIVE, 0xA0 | (slave << 4));
+    ata_delay(device);
+    outb(io + ATA_REG_COUNT, 0);
+    outb(io + ATA_REG_LBA0, 0);
+    outb(io + ATA_REG_LBA1, 0);
+    outb(io + ATA_REG_LBA2, 0);
+    outb(io + ATA_REG_COMMAND, ATA_CMD_IDENTIFY);
+    if(inb(io + ATA_REG_STATUS) == 0) return false;
+
+    // ATAPI/SATA imzası LBA1/LBA2'de sıfır olmayan değer bırakır
+    if(ata_wait(device, false) != 0) return false;
+    if(inb(io + ATA_REG_LBA1) || inb(io + ATA_REG_LBA2)) return false;
+    if(ata_wait(device, true) != 0) return false;
+    insw(io + ATA_REG_DATA, identify, 256);
+
+    if(!(identify[49] & (1 << 9))) return false;    // LBA yok
+
+    device->dma_capable = (identify[49] & (1 << 8)) != 0;
+    device->lba48 = (identify[83] & (1 << 10)) != 0;
+    if(device->lba48) {
+        device->sectors = (uint64_t)identify[100] | ((uint64_t)identify[101] << 16) |
+                          ((uint64_t)identify[102] << 32) | ((uint64_t)identify[103] << 48);
+    } else {
+        device->sectors = (uint32_t)identify[60] | ((uint32_t)identify[61] << 16);
+    }
+
+    // Model adı: kelime başına iki karakter, bayt sırası ters
+    for(int i = 0; i < 20; i++) {
+        device->model[i * 2] = identify[27 + i] >> 8;
+        device->model[i * 2 + 1] = identify[27 + i] & 0xFF;
+    }
+    int length = 40;
+    while(length > 0 && device->model[length - 1] == ' ') length--;
+    device->model[length] = 0;
+
+    device->present = true;
+    return true;
+}
+
+// PCI IDE denetleyicisinin bus-master G/Ç tabanını kullan (ikincil kanal +8)
+bool ata_enable_dma(ata_device_t *device, uint16_t bmide_base) {
+    if(!device->present || !device->dma_capable || !bmide_base) return false;
+
+    device->bmide_base = bmide_base + (device->io_base == ATA_SECONDARY_IO ? 8 : 0);
+    device->dma = true;
+    return true;
+}
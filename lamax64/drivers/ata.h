@@ -0,0 +1,56 @@
+#ifndef ATA_H
+#define ATA_H
+
+#include <system.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Birincil IDE kanalı
+#define ATA_PRIMARY_IO          0x1F0
+#define ATA_PRIMARY_CTRL        0x3F6
+#define ATA_SECONDARY_IO        0x170
+#define ATA_SECONDARY_CTRL      0x376
+
+#define ATA_SECTOR_SIZE         512
+
+// PIO komutu başına en fazla sektör (LBA28 sayacı 0 = 256)
+#define ATA_PIO_MAX_SECTORS     256
+
+// DMA: bu boyuttan küçük okumalar PIO ile yapılır
+#define ATA_DMA_MIN_SECTORS     16
+#define ATA_DMA_MAX_SECTORS     2048
+#define ATA_PRD_ENTRIES         32
+#define ATA_DMA_LIMIT           0x100000000ULL  // PRD adresleri 32 bittir
+
+// Bus-master DMA fiziksel bölge tanımlayıcısı (PRD)
+typedef struct {
+    uint32_t address;
+    uint16_t byte_count;        // 0 = 64 KB
+    uint16_t flags;             // bit 15: tablonun sonu
+} __attribute__((packed)) ata_prd_t;
+
+// Kanal üzerindeki tek bir ATA diski
+typedef struct {
+    uint16_t io_base;
+    uint16_t ctrl_base;
+    uint16_t bmide_base;        // 0: bus-master DMA yok
+    bool slave;
+    bool present;
+    bool lba48;
+    bool dma_capable;
+    bool dma;
+    uint64_t sectors;
+    char model[41];
+} ata_device_t;
+
+// Function Prototypes
+bool ata_init(ata_device_t *device, uint16_t io_base, uint16_t ctrl_base, bool slave);
+bool ata_enable_dma(ata_device_t *device, uint16_t bmide_base);
+int ata_read(ata_device_t *device, uint64_t lba, uint32_t count, void *buffer);
+int ata_write(ata_device_t *device, uint64_t lba, uint32_t count, const void *buffer);
+int ata_flush(ata_device_t *device);
+
+// PCI IDE denetleyicisi (sadece kernel)
+ata_device_t *ide_init(void);
+
+#endif // ATA_H
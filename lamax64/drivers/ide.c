@@ -0,0 +1,73 @@
+/*
+ * LAMAX64 OS - PCI IDE Denetleyicisi
+ * Version 1.0.0
+ *
+ * Birincil kanaldaki açılış diskini tanır ve denetleyici bus-master
+ * destekliyorsa (prog_if bit 7, BAR4) büyük aktarımlar için DMA'yı açar.
+ * Disk "ata0" adıyla blok katmanına kaydedilir; aktarımlar yoklamalı
+ * olduğundan istekler submit içinde tamamlanır.
+ */
+
+#include "system.h"
+#include "pci_driver.h"
+#include "ata.h"
+
+#define PCI_CLASS_STORAGE       0x01
+#define PCI_SUBCLASS_IDE        0x01
+#define IDE_PROG_IF_BUS_MASTER  0x80
+#define IDE_BMIDE_BAR           4
+
+static ata_device_t ide_boot_disk;
+static block_device_t ide_block;
+
+static int ide_submit(block_device_t *device, block_request_t *requests) {
+    ata_device_t* disk = (ata_device_t*)device->driver_data;
+
+    while(requests) {
+        // complete isteği yeniden kullanabilir: sonrakini önceden al
+        block_request_t* request = requests;
+        requests = request->next;
+
+        if(request->write) request->status = ata_write(disk, request->lba, request->count, request->buffer);
+        else request->status = ata_read(disk, request->lba, request->count, request->buffer);
+        if(request->complete) request->complete(request);
+    }
+    return 0;
+}
+
+static int ide_flush(block_device_t *device) {
+    return ata_flush((ata_device_t*)device->driver_data);
+}
+
+static void ide_register_block(void) {
+    ide_block.name = "ata0";
+    ide_block.sectors = ide_boot_disk.sectors;
+    ide_block.max_sectors = ATA_DMA_MAX_SECTORS;
+    ide_block.queue_depth = 1;
+    ide_block.interrupt_driven = false;
+    ide_block.submit = ide_submit;
+    ide_block.flush = ide_flush;
+    ide_block.poll = NULL;
+    ide_block.driver_data = &ide_boot_disk;
+    block_register(&ide_block);
+}
+
+ata_device_t *ide_init(void) {
+    if(!ata_init(&ide_boot_disk, ATA_PRIMARY_IO, ATA_PRIMARY_CTRL, false)) return NULL;
+    ide_register_block();
+
+    pci_init();
+    pci_device_t* controller = pci_find_class(PCI_CLASS_STORAGE, PCI_SUBCLASS_IDE, PCI_ANY_PROG_IF);
+    if(!controller || !(controller->prog_if & IDE_PROG_IF_BUS_MASTER)) return &ide_boot_disk;
+
+    // Bus-master yazmaçları G/Ç alanında olmalı
+    uint64_t bmide = pci_get_bar_address(controller, IDE_BMIDE_BAR);
+    if(!(controller->bars[IDE_BMIDE_BAR] & PCI_ADDRESS_SPACE_IO) || !bmide || bmide > 0xFFFF) {
+        return &ide_boot_disk;
+    }
+
+    pci_enable_device(controller);
+    pci_set_master(controller, true);
+    ata_enable_dma(&ide_boot_disk, (uint16_t)bmide);
+    return &ide_boot_disk;
+}
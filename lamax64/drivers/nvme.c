@@ -0,0 +1,433 @@
+/*
+ * LAMAX64 OS - NVMe Sürücüsü
+ * Version 1.0.0
+ *
+ * PCI sınıf 01h/08h denetleyicisini tanır, ilk ad alanını "nvme0n1"
+ * adıyla blok katmanına kaydeder. Her işlemciye kendi G/Ç kuyruk çifti
+ * ve MSI-X vektörü verilir: gönderim yalnızca yerel kesmeleri kapatır,
+ * işlemciler arasında paylaşılan kilit yoktur. İki sayfayı aşan
+ * aktarımlar komut başına ayrılmış PRP listesiyle tanımlanır.
+ */
+
+#include "system.h"
+#include "pci_driver.h"
+#include "nvme.h"
+
+#define NVME_ADMIN_TIMEOUT_MS   1000
+
+typedef struct {
+    uint16_t id;
+    uint16_t depth;
+    volatile nvme_command_t* sq;
+    volatile nvme_completion_t* cq;
+    uint64_t (*prp_lists)[NVME_PRP_LIST_ENTRIES];
+    volatile uint32_t* sq_doorbell;
+    volatile uint32_t* cq_doorbell;
+    uint16_t sq_tail;
+    uint16_t doorbell_tail;     // Aygıta son bildirilen SQ kuyruğu
+    uint16_t cq_head;
+    uint16_t cq_phase;
+
+    // Komut kimliği = istek yuvası; boş yuvalar tek bağlı listede
+    uint16_t free_cid;
+    uint16_t num_free;
+    uint16_t next_cid[NVME_IO_QUEUE_DEPTH];
+    block_request_t* inflight[NVME_IO_QUEUE_DEPTH];
+} nvme_queue_t;
+
+// G/Ç kuyruğu başına tek fiziksel bitişik alan (sayfa ayırıcıdan)
+typedef struct {
+    nvme_command_t sq[NVME_IO_QUEUE_DEPTH];
+    nvme_completion_t cq[NVME_IO_QUEUE_DEPTH];
+    uint64_t prp_lists[NVME_IO_QUEUE_DEPTH][NVME_PRP_LIST_ENTRIES];
+} __attribute__((aligned(NVME_PAGE_SIZE))) nvme_queue_memory_t;
+
+typedef struct {
+    bool present;
+    volatile uint8_t* regs;
+    uint32_t doorbell_stride;
+    uint32_t timeout_ms;
+    uint32_t nsid;
+    bool write_cache;
+
+    nvme_queue_t admin;
+    nvme_queue_t io[NVME_MAX_IO_QUEUES];
+    int io_queue_count;
+} nvme_controller_t;
+
+static nvme_command_t nvme_admin_sq[NVME_ADMIN_QUEUE_DEPTH] __attribute__((aligned(NVME_PAGE_SIZE)));
+static nvme_completion_t nvme_admin_cq[NVME_ADMIN_QUEUE_DEPTH] __attribute__((aligned(NVME_PAGE_SIZE)));
+static uint8_t nvme_identify_buffer[NVME_PAGE_SIZE] __attribute__((aligned(NVME_PAGE_SIZE)));
+static nvme_controller_t nvme;
+static block_device_t nvme_block;
+
+static inline uint32_t nvme_read32(uint32_t reg) {
+    return *(volatile uint32_t*)(nvme.regs + reg);
+}
+
+static inline void nvme_write32(uint32_t reg, uint32_t value) {
+    *(volatile uint32_t*)(nvme.regs + reg) = value;
+}
+
+static inline uint64_t nvme_read64(uint32_t reg) {
+    return nvme_read32(reg) | ((uint64_t)nvme_read32(reg + 4) << 32);
+}
+
+static inline void nvme_write64(uint32_t reg, uint64_t value) {
+    nvme_write32(reg, (uint32_t)value);
+    nvme_write32(reg + 4, (uint32_t)(value >> 32));
+}
+
+static bool nvme_wait_ready(bool ready) {
+    uint64_t deadline = ktime_ns() + (uint64_t)nvme.timeout_ms * 1000000;
+
+    while(((nvme_read32(NVME_REG_CSTS) & NVME_CSTS_READY) != 0) != ready) {
+        if(nvme_read32(NVME_REG_CSTS) & NVME_CSTS_FATAL) return false;
+        if(ktime_expired(deadline)) return false;
+        __asm__ volatile("pause");
+    }
+    return true;
+}
+
+static void nvme_init_queue(nvme_queue_t* queue, uint16_t id, uint16_t depth,
+                            nvme_command_t* sq, nvme_completion_t* cq) {
+    uint8_t* cq_bytes = (uint8_t*)cq;
+    for(uint32_t i = 0; i < depth * sizeof(nvme_completion_t); i++) cq_bytes[i] = 0;
+
+    queue->id = id;
+    queue->depth = depth;
+    queue->sq = sq;
+    queue->cq = cq;
+    queue->sq_doorbell = (volatile uint32_t*)(nvme.regs + NVME_REG_DOORBELL + (2 * id) * nvme.doorbell_stride);
+    queue->cq_doorbell = (volatile uint32_t*)(nvme.regs + NVME_REG_DOORBELL + (2 * id + 1) * nvme.doorbell_stride);
+    queue->sq_tail = 0;
+    queue->doorbell_tail = 0;
+    queue->cq_head = 0;
+    queue->cq_phase = 1;
+
+    // SQ en fazla depth - 1 komut tutar
+    queue->free_cid = 0;
+    queue->num_free = depth - 1;
+    for(uint16_t cid = 0; cid < depth && cid < NVME_IO_QUEUE_DEPTH; cid++) {
+        queue->next_cid[cid] = cid + 1;
+        queue->inflight[cid] = NULL;
+    }
+}
+
+static void nvme_push_command(nvme_queue_t* queue, const nvme_command_t* command) {
+    queue->sq[queue->sq_tail] = *command;
+    if(++queue->sq_tail == queue->depth) queue->sq_tail = 0;
+}
+
+// Kuyruğa eklenen tüm komutlar için tek doorbell yazması
+static void nvme_ring(nvme_queue_t* queue) {
+    if(queue->sq_tail == queue->doorbell_tail) return;
+
+    __sync_synchronize();
+    *queue->sq_doorbell = queue->sq_tail;
+    queue->doorbell_tail = queue->sq_tail;
+}
+
+// Senkron yönetim komutu (yoklamalı; yalnızca probe sırasında)
+static int nvme_admin_command(nvme_command_t* command, uint32_t* result) {
+    nvme_queue_t* queue = &nvme.admin;
+
+    command->cid = queue->sq_tail;
+    nvme_push_command(queue, command);
+    nvme_ring(queue);
+
+    uint64_t deadline = ktime_ns() + (uint64_t)NVME_ADMIN_TIMEOUT_MS * 1000000;
+    volatile nvme_completion_t* entry = &queue->cq[queue->cq_head];
+    while((entry->status & 1) != queue->cq_phase) {
+        if(ktime_expired(deadline)) return -1;
+        __asm__ volatile("pause");
+    }
+
+    uint16_t status = entry->status >> 1;
+    if(result) *result = entry->result;
+    if(++queue->cq_head == queue->depth) {
+        queue->cq_head = 0;
+        queue->cq_phase ^= 1;
+    }
+    *queue->cq_doorbell = queue->cq_head;
+    return status ? -1 : 0;
+}
+
+static int nvme_identify(uint32_t nsid, uint32_t cns) {
+    nvme_command_t command = {0};
+
+    command.opcode = NVME_ADMIN_IDENTIFY;
+    command.nsid = nsid;
+    command.prp1 = (uintptr_t)nvme_identify_buffer;
+    command.cdw10 = cns;
+    return nvme_admin_command(&command, NULL);
+}
+
+// Tamamlanan komutları topla; kesmeler kapalıyken çağrılır
+static void nvme_process_queue(nvme_queue_t* queue) {
+    bool progressed = false;
+
+    while(1) {
+        volatile nvme_completion_t* entry = &queue->cq[queue->cq_head];
+        uint16_t status = entry->status;
+        if((status & 1) != queue->cq_phase) break;
+
+        uint16_t cid = entry->cid;
+        if(++queue->cq_head == queue->depth) {
+            queue->cq_head = 0;
+            queue->cq_phase ^= 1;
+        }
+        progressed = true;
+        if(cid >= queue->depth) continue;
+
+        block_request_t* request = queue->inflight[cid];
+        queue->inflight[cid] = NULL;
+        queue->next_cid[cid] = queue->free_cid;
+        queue->free_cid = cid;
+        queue->num_free++;
+
+        if(request) {
+            request->status = (status >> 1) ? -1 : 0;
+            if(request->complete) request->complete(request);
+        }
+    }
+
+    if(progressed) *queue->cq_doorbell = queue->cq_head;
+}
+
+static void nvme_irq_0(void) { nvme_process_queue(&nvme.io[0]); }
+static void nvme_irq_1(void) { nvme_process_queue(&nvme.io[1]); }
+static void nvme_irq_2(void) { nvme_process_queue(&nvme.io[2]); }
+static void nvme_irq_3(void) { nvme_process_queue(&nvme.io[3]); }
+
+static void (*const nvme_irq_handlers[NVME_MAX_IO_QUEUES])(void) = {
+    nvme_irq_0, nvme_irq_1, nvme_irq_2, nvme_irq_3
+};
+
+// PRP1 ilk sayfayı, PRP2 ikinci sayfayı ya da geri kalanların listesini gösterir
+static void nvme_build_prp(nvme_queue_t* queue, uint16_t cid, nvme_command_t* command,
+                           uintptr_t buffer, uint32_t bytes) {
+    uint32_t first = NVME_PAGE_SIZE - (buffer & (NVME_PAGE_SIZE - 1));
+
+    command->prp1 = buffer;
+    if(bytes <= first) return;
+
+    uintptr_t next = buffer + first;
+    if(bytes - first <= NVME_PAGE_SIZE) {
+        command->prp2 = next;
+        return;
+    }
+
+    uint64_t* list = queue->prp_lists[cid];
+    uint32_t count = 0;
+    for(uintptr_t page = next; page < buffer + bytes; page += NVME_PAGE_SIZE) list[count++] = page;
+    command->prp2 = (uintptr_t)list;
+}
+
+static void nvme_queue_request(nvme_queue_t* queue, block_request_t* request, uint8_t opcode) {
+    nvme_command_t command = {0};
+    uint16_t cid = queue->free_cid;
+
+    queue->free_cid = queue->next_cid[cid];
+    queue->num_free--;
+    queue->inflight[cid] = request;
+
+    command.opcode = opcode;
+    command.cid = cid;
+    command.nsid = nvme.nsid;
+    if(request->count) {
+        nvme_build_prp(queue, cid, &command, (uintptr_t)request->buffer, request->count * BLOCK_SECTOR_SIZE);
+        command.cdw10 = (uint32_t)request->lba;
+        command.cdw11 = (uint32_t)(request->lba >> 32);
+        command.cdw12 = request->count - 1;
+    }
+    nvme_push_command(queue, &command);
+}
+
+// Boş yuva kalmadıysa bekleyenleri bildir ve tamamlanma topla
+static void nvme_reserve(nvme_queue_t* queue) {
+    while(queue->num_free == 0) {
+        nvme_ring(queue);
+        nvme_process_queue(queue);
+        __asm__ volatile("pause");
+    }
+}
+
+static nvme_queue_t* nvme_local_queue(void) {
+    return &nvme.io[cpu_current() % nvme.io_queue_count];
+}
+
+static int nvme_submit(block_device_t *device, block_request_t *requests) {
+    (void)device;
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    nvme_queue_t* queue = nvme_local_queue();
+    while(requests) {
+        // complete isteği yeniden kullanabilir: sonrakini önceden al
+        block_request_t* request = requests;
+        requests = request->next;
+
+        nvme_reserve(queue);
+        nvme_queue_request(queue, request, request->write ? NVME_CMD_WRITE : NVME_CMD_READ);
+    }
+    nvme_ring(queue);
+    if(enabled) enable_interrupts();
+    return 0;
+}
+
+static void nvme_poll(block_device_t *device) {
+    (void)device;
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    for(int i = 0; i < nvme.io_queue_count; i++) nvme_process_queue(&nvme.io[i]);
+    if(enabled) enable_interrupts();
+}
+
+static int nvme_flush(block_device_t *device) {
+    if(!nvme.write_cache) return 0;
+
+    block_request_t request = {0};
+    request.status = BLOCK_PENDING;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    nvme_queue_t* queue = nvme_local_queue();
+    nvme_reserve(queue);
+    nvme_queue_request(queue, &request, NVME_CMD_FLUSH);
+    nvme_ring(queue);
+    if(enabled) enable_interrupts();
+
+    block_wait(device, &request);
+    return request.status;
+}
+
+static bool nvme_create_io_queue(int index, uint16_t depth, bool msix) {
+    uint32_t pages = (sizeof(nvme_queue_memory_t) + PAGE_SIZE - 1) / PAGE_SIZE;
+    nvme_queue_memory_t* memory = (nvme_queue_memory_t*)pmm_alloc_contiguous(pages, NVME_PAGE_SIZE, PMM_ZONE_NORMAL);
+    nvme_queue_t* queue = &nvme.io[index];
+    nvme_command_t command = {0};
+    uint16_t id = index + 1;
+
+    if(!memory) return false;
+    nvme_init_queue(queue, id, depth, memory->sq, memory->cq);
+    queue->prp_lists = memory->prp_lists;
+
+    // CQ: fiziksel bitişik, kesme açıksa MSI-X girdisi = kuyruk sırası
+    command.opcode = NVME_ADMIN_CREATE_CQ;
+    command.prp1 = (uintptr_t)memory->cq;
+    command.cdw10 = ((uint32_t)(depth - 1) << 16) | id;
+    command.cdw11 = ((uint32_t)index << 16) | (msix ? 0x2 : 0) | 0x1;
+    if(nvme_admin_command(&command, NULL) != 0) {
+        pmm_free_contiguous((uintptr_t)memory, pages);
+        return false;
+    }
+
+    command.opcode = NVME_ADMIN_CREATE_SQ;
+    command.prp1 = (uintptr_t)memory->sq;
+    command.cdw10 = ((uint32_t)(depth - 1) << 16) | id;
+    command.cdw11 = ((uint32_t)id << 16) | 0x1;
+    // Başarısızsa CQ aygıtta kalır: alan geri verilmez
+    return nvme_admin_command(&command, NULL) == 0;
+}
+
+static bool nvme_probe(pci_device_t *device) {
+    // Tek denetleyici: durum statik
+    if(nvme.present) return false;
+
+    uint64_t bar = pci_get_bar_address(device, 0);
+    if((device->bars[0] & PCI_ADDRESS_SPACE_IO) || !bar || bar >= 0x100000000ULL) return false;
+
+    nvme.regs = (volatile uint8_t*)(uintptr_t)bar;
+    pci_enable_device(device);
+    pci_set_master(device, true);
+
+    uint64_t cap = nvme_read64(NVME_REG_CAP);
+    if((cap >> 48) & 0xF) return false;    // 4 KB sayfa desteklenmiyor
+    nvme.doorbell_stride = 4 << ((cap >> 32) & 0xF);
+    nvme.timeout_ms = ((cap >> 24) & 0xFF) * 500;
+    if(nvme.timeout_ms == 0) nvme.timeout_ms = 500;
+    uint32_t max_depth = (cap & 0xFFFF) + 1;
+
+    // Denetleyiciyi kapat, yönetim kuyruğunu kur ve yeniden aç
+    nvme_write32(NVME_REG_CC, 0);
+    if(!nvme_wait_ready(false)) return false;
+
+    nvme_init_queue(&nvme.admin, 0, NVME_ADMIN_QUEUE_DEPTH, nvme_admin_sq, nvme_admin_cq);
+    nvme_write32(NVME_REG_AQA, ((NVME_ADMIN_QUEUE_DEPTH - 1) << 16) | (NVME_ADMIN_QUEUE_DEPTH - 1));
+    nvme_write64(NVME_REG_ASQ, (uintptr_t)nvme_admin_sq);
+    nvme_write64(NVME_REG_ACQ, (uintptr_t)nvme_admin_cq);
+    nvme_write32(NVME_REG_CC, NVME_CC_ENABLE | NVME_CC_IOSQES | NVME_CC_IOCQES);
+    if(!nvme_wait_ready(true)) return false;
+
+    // Denetleyici: en büyük aktarım (MDTS) ve yazma önbelleği
+    if(nvme_identify(0, NVME_IDENTIFY_CONTROLLER) != 0) return false;
+    uint8_t mdts = nvme_identify_buffer[77];
+    nvme.write_cache = nvme_identify_buffer[525] & 0x1;
+
+    // Ad alanı 1: boyut ve sektör biçimi (yalnızca 512 bayt)
+    nvme.nsid = 1;
+    if(nvme_identify(nvme.nsid, NVME_IDENTIFY_NAMESPACE) != 0) return false;
+    uint64_t sectors = *(uint64_t*)nvme_identify_buffer;
+    uint8_t format = nvme_identify_buffer[26] & 0xF;
+    uint32_t lba_format = *(uint32_t*)(nvme_identify_buffer + 128 + 4 * format);
+    if(((lba_format >> 16) & 0xFF) != 9) return false;
+
+    // Kuyruk sayısı: işlemci, denetleyici ve sürücü sınırının en küçüğü
+    int count = cpu_count();
+    if(count > NVME_MAX_IO_QUEUES) count = NVME_MAX_IO_QUEUES;
+
+    nvme_command_t command = {0};
+    uint32_t granted;
+    command.opcode = NVME_ADMIN_SET_FEATURES;
+    command.cdw10 = NVME_FEATURE_QUEUES;
+    command.cdw11 = ((uint32_t)(count - 1) << 16) | (count - 1);
+    if(nvme_admin_command(&command, &granted) != 0) return false;
+    if((int)(granted & 0xFFFF) + 1 < count) count = (granted & 0xFFFF) + 1;
+    if((int)(granted >> 16) + 1 < count) count = (granted >> 16) + 1;
+
+    bool msix = pci_setup_msix(device, count);
+    uint16_t depth = max_depth < NVME_IO_QUEUE_DEPTH ? max_depth : NVME_IO_QUEUE_DEPTH;
+
+    nvme.io_queue_count = 0;
+    for(int i = 0; i < count; i++) {
+        if(!nvme_create_io_queue(i, depth, msix)) break;
+        nvme.io_queue_count++;
+        if(msix) register_interrupt_handler(device->msix.base_vector + i, nvme_irq_handlers[i]);
+    }
+    if(nvme.io_queue_count == 0) return false;
+    nvme.present = true;
+
+    uint32_t max_sectors = NVME_MAX_SECTORS;
+    if(mdts && (1u << mdts) * (NVME_PAGE_SIZE / BLOCK_SECTOR_SIZE) < max_sectors) {
+        max_sectors = (1u << mdts) * (NVME_PAGE_SIZE / BLOCK_SECTOR_SIZE);
+    }
+
+    nvme_block.name = "nvme0n1";
+    nvme_block.sectors = sectors;
+    nvme_block.max_sectors = max_sectors;
+    nvme_block.queue_depth = depth - 1;
+    nvme_block.interrupt_driven = msix;
+    nvme_block.submit = nvme_submit;
+    nvme_block.flush = nvme_flush;
+    nvme_block.poll = nvme_poll;
+    nvme_block.driver_data = &nvme;
+    block_register(&nvme_block);
+    return true;
+}
+
+static pci_driver_t nvme_driver = {
+    .name = "nvme",
+    .vendor_id = PCI_ANY_ID,
+    .device_id = PCI_ANY_ID,
+    .class_code = NVME_PCI_CLASS,
+    .subclass = NVME_PCI_SUBCLASS,
+    .prog_if = PCI_ANY_PROG_IF,
+    .probe = nvme_probe,
+};
+
+void nvme_init(void) {
+    pci_init();
+    pci_register_driver(&nvme_driver);
+}
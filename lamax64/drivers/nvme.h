@@ -0,0 +1,81 @@
+#ifndef NVME_H
+#define NVME_H
+
+#include <system.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// PCI sınıfı: yığın depolama / NVM Express
+#define NVME_PCI_CLASS          0x01
+#define NVME_PCI_SUBCLASS       0x08
+
+// Denetleyici yazmaçları (BAR0 MMIO)
+#define NVME_REG_CAP            0x00
+#define NVME_REG_VS             0x08
+#define NVME_REG_CC             0x14
+#define NVME_REG_CSTS           0x1C
+#define NVME_REG_AQA            0x24
+#define NVME_REG_ASQ            0x28
+#define NVME_REG_ACQ            0x30
+#define NVME_REG_DOORBELL       0x1000
+
+#define NVME_CC_ENABLE          0x1
+#define NVME_CC_IOSQES          (6 << 16)   // 64 baytlık SQ girdisi
+#define NVME_CC_IOCQES          (4 << 20)   // 16 baytlık CQ girdisi
+#define NVME_CSTS_READY         0x1
+#define NVME_CSTS_FATAL         0x2
+
+// Yönetim komutları
+#define NVME_ADMIN_CREATE_SQ    0x01
+#define NVME_ADMIN_CREATE_CQ    0x05
+#define NVME_ADMIN_IDENTIFY     0x06
+#define NVME_ADMIN_SET_FEATURES 0x09
+#define NVME_FEATURE_QUEUES     0x07
+#define NVME_IDENTIFY_NAMESPACE 0
+#define NVME_IDENTIFY_CONTROLLER 1
+
+// G/Ç komutları
+#define NVME_CMD_FLUSH          0x00
+#define NVME_CMD_WRITE          0x01
+#define NVME_CMD_READ           0x02
+
+// Kuyruk boyutları: sayfa 4 KB (CC.MPS = 0)
+#define NVME_PAGE_SIZE          4096
+#define NVME_ADMIN_QUEUE_DEPTH  16
+#define NVME_IO_QUEUE_DEPTH     128
+#define NVME_MAX_IO_QUEUES      4
+#define NVME_MAX_SECTORS        512         // 256 KB: 64 girdilik PRP listesi
+#define NVME_PRP_LIST_ENTRIES   64
+
+// Gönderim kuyruğu girdisi
+typedef struct {
+    uint8_t opcode;
+    uint8_t flags;
+    uint16_t cid;
+    uint32_t nsid;
+    uint64_t reserved;
+    uint64_t metadata;
+    uint64_t prp1;
+    uint64_t prp2;
+    uint32_t cdw10;
+    uint32_t cdw11;
+    uint32_t cdw12;
+    uint32_t cdw13;
+    uint32_t cdw14;
+    uint32_t cdw15;
+} __attribute__((packed)) nvme_command_t;
+
+// Tamamlanma kuyruğu girdisi
+typedef struct {
+    uint32_t result;
+    uint32_t reserved;
+    uint16_t sq_head;
+    uint16_t sq_id;
+    uint16_t cid;
+    uint16_t status;                        // bit 0: faz, 1-15: durum
+} __attribute__((packed)) nvme_completion_t;
+
+// Function Prototypes
+void nvme_init(void);
+
+#endif // NVME_H
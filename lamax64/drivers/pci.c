@@ -0,0 +1,325 @@
+/*
+ * LAMAX64 OS - PCI Veriyolu
+ * Version 1.0.0
+ *
+ * Yapılandırma alanına 0xCF8/0xCFC (mekanizma #1) ile erişilir.
+ * Açılışta tüm veriyolları bir kez taranır; sürücüler aygıtları
+ * üretici/aygıt kimliği ya da sınıf koduyla bu tablodan bulur ya da
+ * pci_register_driver ile eşleşen aygıtlar için probe alır. MSI-X
+ * tabloları kimlik eşlemesiyle (4 GB altı) doğrudan programlanır.
+ */
+
+#include "system.h"
+#include "pci_driver.h"
+
+#define PCI_CONFIG_ADDRESS  0xCF8
+#define PCI_CONFIG_DATA     0xCFC
+
+// Yapılandırma başlığı ofsetleri
+#define PCI_VENDOR_ID       0x00
+#define PCI_COMMAND         0x04
+#define PCI_CLASS_REVISION  0x08
+#define PCI_HEADER_INFO     0x0C
+#define PCI_BAR0            0x10
+#define PCI_SUBSYSTEM       0x2C
+#define PCI_ROM_ADDRESS     0x30
+#define PCI_INTERRUPT       0x3C
+
+#define PCI_CAP_POINTER     0x34
+
+#define PCI_HEADER_MULTIFUNCTION    0x80
+#define PCI_STATUS_CAP_LIST         0x10
+
+// MSI-X ileti kontrolü ve tablo girişi
+#define MSIX_CONTROL_ENABLE     0x8000
+#define MSIX_CONTROL_MASK_ALL   0x4000
+#define MSIX_CONTROL_SIZE_MASK  0x07FF
+#define MSIX_VECTOR_MASKED      0x1
+
+#define PCI_MAX_DRIVERS     16
+
+static pci_device_t pci_devices[PCI_MAX_DEVICES];
+static pci_system_t pci_system;
+static pci_driver_t* pci_drivers[PCI_MAX_DRIVERS];
+static uint32_t pci_driver_count = 0;
+
+uint32_t pci_read_config32(uint8_t bus, uint8_t slot, uint8_t func, uint8_t offset) {
+    outl(PCI_CONFIG_ADDRESS, 0x80000000 | ((uint32_t)bus << 16) | ((uint32_t)slot << 11) |
+                             ((uint32_t)func << 8) | (offset & 0xFC));
+    return inl(PCI_CONFIG_DATA);
+}
+
+void pci_write_config32(uint8_t bus, uint8_t slot, uint8_t func, uint8_t offset, uint32_t value) {
+    outl(PCI_CONFIG_ADDRESS, 0x80000000 | ((uint32_t)bus << 16) | ((uint32_t)slot << 11) |
+                             ((uint32_t)func << 8) | (offset & 0xFC));
+    outl(PCI_CONFIG_DATA, value);
+}
+
+uint8_t pci_read_config8(pci_device_t *device, uint8_t offset) {
+    uint32_t value = pci_read_config32(device->bus, device->slot, device->function, offset);
+    return (value >> ((offset & 3) * 8)) & 0xFF;
+}
+
+uint16_t pci_read_config16(pci_device_t *device, uint8_t offset) {
+    uint32_t value = pci_read_config32(device->bus, device->slot, device->function, offset);
+    return (value >> ((offset & 2) * 8)) & 0xFFFF;
+}
+
+void pci_write_config16(pci_device_t *device, uint8_t offset, uint16_t value) {
+    uint32_t shift = (offset & 2) * 8;
+    uint32_t old = pci_read_config32(device->bus, device->slot, device->function, offset);
+    old = (old & ~(0xFFFF << shift)) | ((uint32_t)value << shift);
+    pci_write_config32(device->bus, device->slot, device->function, offset, old);
+}
+
+// Bir fonksiyonun tip 0 başlığını tabloya oku
+static void pci_read_device(uint8_t bus, uint8_t slot, uint8_t func, uint32_t id) {
+    if(pci_system.device_count >= PCI_MAX_DEVICES) return;
+    pci_device_t* device = &pci_devices[pci_system.device_count++];
+
+    uint32_t class_rev = pci_read_config32(bus, slot, func, PCI_CLASS_REVISION);
+    uint32_t header = pci_read_config32(bus, slot, func, PCI_HEADER_INFO);
+    uint32_t command = pci_read_config32(bus, slot, func, PCI_COMMAND);
+    uint32_t subsystem = pci_read_config32(bus, slot, func, PCI_SUBSYSTEM);
+    uint32_t interrupt = pci_read_config32(bus, slot, func, PCI_INTERRUPT);
+
+    device->bus = bus;
+    device->slot = slot;
+    device->function = func;
+    device->vendor_id = id & 0xFFFF;
+    device->device_id = id >> 16;
+    device->command = command & 0xFFFF;
+    device->status = command >> 16;
+    device->revision_id = class_rev & 0xFF;
+    device->prog_if = (class_rev >> 8) & 0xFF;
+    device->subclass = (class_rev >> 16) & 0xFF;
+    device->class_code = class_rev >> 24;
+    device->cache_line_size = header & 0xFF;
+    device->latency_timer = (header >> 8) & 0xFF;
+    device->header_type = (header >> 16) & 0x7F;
+    device->bist = header >> 24;
+    device->subsys_vendor_id = subsystem & 0xFFFF;
+    device->subsys_device_id = subsystem >> 16;
+    device->rom_address = pci_read_config32(bus, slot, func, PCI_ROM_ADDRESS);
+    device->interrupt_line = interrupt & 0xFF;
+    device->interrupt_pin = (interrupt >> 8) & 0xFF;
+    device->min_grant = (interrupt >> 16) & 0xFF;
+    device->max_latency = interrupt >> 24;
+
+    for(int i = 0; i < 6; i++) {
+        device->bars[i] = device->header_type == 0 ?
+            pci_read_config32(bus, slot, func, PCI_BAR0 + i * 4) : 0;
+    }
+}
+
+void pci_scan_all(void) {
+    pci_system.device_count = 0;
+
+    for(uint32_t bus = 0; bus < 256; bus++) {
+        for(uint8_t slot = 0; slot < 32; slot++) {
+            uint32_t id = pci_read_config32(bus, slot, 0, PCI_VENDOR_ID);
+            if((id & 0xFFFF) == 0xFFFF) continue;
+
+            uint32_t header = pci_read_config32(bus, slot, 0, PCI_HEADER_INFO);
+            uint8_t functions = (header >> 16) & PCI_HEADER_MULTIFUNCTION ? 8 : 1;
+
+            for(uint8_t func = 0; func < functions; func++) {
+                if(func) id = pci_read_config32(bus, slot, func, PCI_VENDOR_ID);
+                if((id & 0xFFFF) == 0xFFFF) continue;
+                pci_read_device(bus, slot, func, id);
+            }
+        }
+    }
+}
+
+void pci_init(void) {
+    if(pci_system.initialized) return;
+
+    pci_scan_all();
+    pci_system.initialized = true;
+}
+
+pci_device_t *pci_find_device(uint16_t vendor_id, uint16_t device_id) {
+    for(uint32_t i = 0; i < pci_system.device_count; i++) {
+        if(pci_devices[i].vendor_id == vendor_id && pci_devices[i].device_id == device_id) {
+            return &pci_devices[i];
+        }
+    }
+    return NULL;
+}
+
+// prog_if PCI_ANY_PROG_IF ise sadece sınıf/alt sınıf karşılaştırılır
+pci_device_t *pci_find_class(uint8_t class_code, uint8_t subclass, uint8_t prog_if) {
+    for(uint32_t i = 0; i < pci_system.device_count; i++) {
+        pci_device_t* device = &pci_devices[i];
+        if(device->class_code == class_code && device->subclass == subclass &&
+           (prog_if == PCI_ANY_PROG_IF || device->prog_if == prog_if)) {
+            return device;
+        }
+    }
+    return NULL;
+}
+
+static void pci_update_command(pci_device_t *device, uint16_t set, uint16_t clear) {
+    uint32_t value = pci_read_config32(device->bus, device->slot, device->function, PCI_COMMAND);
+    value = (value & 0xFFFF0000) | ((value & ~clear & 0xFFFF) | set);
+    pci_write_config32(device->bus, device->slot, device->function, PCI_COMMAND, value);
+    device->command = value & 0xFFFF;
+}
+
+void pci_enable_device(pci_device_t *device) {
+    pci_update_command(device, PCI_COMMAND_IO | PCI_COMMAND_MEMORY, 0);
+}
+
+void pci_disable_device(pci_device_t *device) {
+    pci_update_command(device, 0, PCI_COMMAND_IO | PCI_COMMAND_MEMORY | PCI_COMMAND_MASTER);
+}
+
+void pci_set_master(pci_device_t *device, bool enable) {
+    if(enable) pci_update_command(device, PCI_COMMAND_MASTER, 0);
+    else pci_update_command(device, 0, PCI_COMMAND_MASTER);
+}
+
+// BAR taban adresi: G/Ç portu ya da (64-bit olabilen) bellek adresi
+uint64_t pci_get_bar_address(pci_device_t *device, uint8_t bar_index) {
+    if(bar_index >= 6) return 0;
+
+    uint32_t bar = device->bars[bar_index];
+    if(bar & PCI_ADDRESS_SPACE_IO) return bar & ~0x3;
+
+    uint64_t address = bar & ~0xF;
+    if((bar & 0x6) == PCI_ADDRESS_MEM_64BIT && bar_index < 5) {
+        address |= (uint64_t)device->bars[bar_index + 1] << 32;
+    }
+    return address;
+}
+
+// Yetenek listesinde cap_id'yi ara; yoksa 0
+uint8_t pci_find_capability(pci_device_t *device, uint8_t cap_id) {
+    if(!(device->status & PCI_STATUS_CAP_LIST)) return 0;
+
+    uint8_t offset = pci_read_config8(device, PCI_CAP_POINTER) & 0xFC;
+    for(int guard = 0; offset && guard < 48; guard++) {
+        uint32_t header = pci_read_config32(device->bus, device->slot, device->function, offset);
+        if((header & 0xFF) == cap_id) return offset;
+        offset = (header >> 8) & 0xFC;
+    }
+    return 0;
+}
+
+// vector_count ardışık vektör ayırıp ilk vector_count girişi BSP'ye
+// yönlendir; kalan girişler maskeli kalır. Vektörler msix.base_vector'dan
+// başlar.
+bool pci_setup_msix(pci_device_t *device, uint32_t vector_count) {
+    msix_info_t* msix = &device->msix;
+    uint8_t cap = pci_find_capability(device, PCI_CAP_ID_MSIX);
+    if(!cap) return false;
+
+    uint16_t control = pci_read_config16(device, cap + 2);
+    uint32_t table = pci_read_config32(device->bus, device->slot, device->function, cap + 4);
+    uint32_t pba = pci_read_config32(device->bus, device->slot, device->function, cap + 8);
+
+    msix->supported = true;
+    msix->offset = cap;
+    msix->table_size = (control & MSIX_CONTROL_SIZE_MASK) + 1;
+    msix->table_bir = table & 0x7;
+    msix->table_offset = table & ~0x7;
+    msix->pba_bir = pba & 0x7;
+    msix->pba_offset = pba & ~0x7;
+    if(vector_count == 0 || vector_count > msix->table_size) return false;
+
+    // Sayfalama yok: tablo 4 GB altında kimlik eşlemesiyle erişilir
+    uint64_t table_bar = pci_get_bar_address(device, msix->table_bir);
+    uint64_t pba_bar = pci_get_bar_address(device, msix->pba_bir);
+    if(!table_bar || table_bar >= 0x100000000ULL || pba_bar >= 0x100000000ULL) return false;
+
+    int vector = interrupt_alloc_vectors(vector_count);
+    if(!vector) return false;
+
+    msix->table_virt = (msix_table_entry_t*)(uintptr_t)(table_bar + msix->table_offset);
+    msix->pba_virt = (uint64_t*)(uintptr_t)(pba_bar + msix->pba_offset);
+    msix->base_vector = vector;
+
+    // Girdi i, i. işlemciye teslim edilir (kuyruk başına işlemci)
+    // Tablo programlanırken tüm vektörler maskeli
+    pci_enable_device(device);
+    pci_write_config16(device, cap + 2, control | MSIX_CONTROL_ENABLE | MSIX_CONTROL_MASK_ALL);
+
+    volatile msix_table_entry_t* entries = msix->table_virt;
+    for(uint32_t i = 0; i < msix->table_size; i++) {
+        if(i < vector_count) {
+            uint32_t address, data;
+            interrupt_msi_message(vector + i, i % cpu_count(), &address, &data);
+            entries[i].msg_addr_low = address;
+            entries[i].msg_addr_high = 0;
+            entries[i].msg_data = data;
+            entries[i].vector_control = 0;
+        } else {
+            entries[i].vector_control = MSIX_VECTOR_MASKED;
+        }
+    }
+
+    pci_write_config16(device, cap + 2, (control | MSIX_CONTROL_ENABLE) & ~MSIX_CONTROL_MASK_ALL);
+    pci_update_command(device, PCI_COMMAND_INTX_DISABLE, 0);
+    msix->enabled = true;
+    return true;
+}
+
+void pci_disable_msix(pci_device_t *device) {
+    msix_info_t* msix = &device->msix;
+    if(!msix->enabled) return;
+
+    uint16_t control = pci_read_config16(device, msix->offset + 2);
+    pci_write_config16(device, msix->offset + 2, control & ~MSIX_CONTROL_ENABLE);
+    pci_update_command(device, 0, PCI_COMMAND_INTX_DISABLE);
+    msix->enabled = false;
+}
+
+static bool pci_driver_matches(pci_driver_t *driver, pci_device_t *device) {
+    if(driver->vendor_id != PCI_ANY_ID && driver->vendor_id != device->vendor_id) return false;
+    if(driver->device_id != PCI_ANY_ID && driver->device_id != device->device_id) return false;
+    if(driver->class_code != PCI_ANY_CLASS && driver->class_code != device->class_code) return false;
+    if(driver->subclass != PCI_ANY_CLASS && driver->subclass != device->subclass) return false;
+    if(driver->prog_if != PCI_ANY_PROG_IF && driver->prog_if != device->prog_if) return false;
+    return true;
+}
+
+// Sürücüyü ekle ve eşleşen sahipsiz aygıtlar için probe çağır;
+// en az bir aygıta bağlandıysa true
+bool pci_register_driver(pci_driver_t *driver) {
+    bool bound = false;
+
+    if(pci_driver_count >= PCI_MAX_DRIVERS) return false;
+    pci_init();
+    pci_drivers[pci_driver_count++] = driver;
+
+    for(uint32_t i = 0; i < pci_system.device_count; i++) {
+        pci_device_t* device = &pci_devices[i];
+        if(device->driver || !pci_driver_matches(driver, device)) continue;
+
+        if(driver->probe && driver->probe(device)) {
+            device->driver = driver;
+            bound = true;
+        }
+    }
+    return bound;
+}
+
+bool pci_unregister_driver(pci_driver_t *driver) {
+    uint32_t index = 0;
+
+    while(index < pci_driver_count && pci_drivers[index] != driver) index++;
+    if(index == pci_driver_count) return false;
+
+    for(uint32_t i = 0; i < pci_system.device_count; i++) {
+        if(pci_devices[i].driver != driver) continue;
+        if(driver->remove) driver->remove(&pci_devices[i]);
+        pci_devices[i].driver = NULL;
+    }
+
+    for(; index + 1 < pci_driver_count; index++) {
+        pci_drivers[index] = pci_drivers[index + 1];
+    }
+    pci_driver_count--;
+    return true;
+}
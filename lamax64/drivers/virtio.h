@@ -0,0 +1,79 @@
+#ifndef VIRTIO_H
+#define VIRTIO_H
+
+#include <system.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// PCI kimlikleri (geçiş/legacy aygıtlar)
+#define VIRTIO_PCI_VENDOR           0x1AF4
+#define VIRTIO_PCI_DEVICE_BLK       0x1001
+
+// Legacy PCI G/Ç yazmaçları (BAR0)
+#define VIRTIO_PCI_HOST_FEATURES    0x00
+#define VIRTIO_PCI_GUEST_FEATURES   0x04
+#define VIRTIO_PCI_QUEUE_PFN        0x08
+#define VIRTIO_PCI_QUEUE_SIZE       0x0C
+#define VIRTIO_PCI_QUEUE_SELECT     0x0E
+#define VIRTIO_PCI_QUEUE_NOTIFY     0x10
+#define VIRTIO_PCI_STATUS           0x12
+#define VIRTIO_PCI_ISR              0x13
+#define VIRTIO_MSI_CONFIG_VECTOR    0x14
+#define VIRTIO_MSI_QUEUE_VECTOR     0x16
+#define VIRTIO_MSI_NO_VECTOR        0xFFFF
+
+// Aygıta özgü yapılandırma alanı (MSI-X açıkken 4 bayt kayar)
+#define VIRTIO_PCI_CONFIG           0x14
+#define VIRTIO_PCI_CONFIG_MSIX      0x18
+
+#define VIRTIO_PCI_QUEUE_ALIGN      4096
+
+// Aygıt durum bitleri
+#define VIRTIO_STATUS_ACKNOWLEDGE   0x01
+#define VIRTIO_STATUS_DRIVER        0x02
+#define VIRTIO_STATUS_DRIVER_OK     0x04
+#define VIRTIO_STATUS_FAILED        0x80
+
+// Tanımlayıcı bayrakları
+#define VRING_DESC_F_NEXT           0x1
+#define VRING_DESC_F_WRITE          0x2
+#define VRING_USED_F_NO_NOTIFY      0x1
+
+// Bölünmüş (split) sanal kuyruk yapıları
+typedef struct {
+    uint64_t addr;
+    uint32_t len;
+    uint16_t flags;
+    uint16_t next;
+} __attribute__((packed)) vring_desc_t;
+
+typedef struct {
+    uint16_t flags;
+    uint16_t idx;
+    uint16_t ring[];
+} __attribute__((packed)) vring_avail_t;
+
+typedef struct {
+    uint32_t id;
+    uint32_t len;
+} __attribute__((packed)) vring_used_elem_t;
+
+typedef struct {
+    uint16_t flags;
+    uint16_t idx;
+    vring_used_elem_t ring[];
+} __attribute__((packed)) vring_used_t;
+
+// Legacy yerleşim: tanımlayıcılar + avail, sayfa hizalı used
+#define VRING_AVAIL_BYTES(size)     (4 + 2 * (size) + 2)
+#define VRING_USED_OFFSET(size)     ((16 * (size) + VRING_AVAIL_BYTES(size) + \
+                                      VIRTIO_PCI_QUEUE_ALIGN - 1) & ~(VIRTIO_PCI_QUEUE_ALIGN - 1))
+#define VRING_BYTES(size)           (VRING_USED_OFFSET(size) + 4 + 8 * (size) + 2)
+
+// Halkalar aygıtla paylaşılır: yayınlamadan önce tam bariyer
+#define virtio_mb()                 __sync_synchronize()
+
+// Function Prototypes
+void virtio_blk_init(void);
+
+#endif // VIRTIO_H
@@ -0,0 +1,305 @@
+/*
+ * LAMAX64 OS - virtio-blk Sürücüsü
+ * Version 1.0.0
+ *
+ * QEMU/KVM sanal diskleri için legacy virtio PCI arayüzü (BAR0 G/Ç)
+ * ve tek bölünmüş sanal kuyruk. Her istek başlık + veri + durum
+ * tanımlayıcı zinciridir; submit listedeki tüm istekleri halkaya
+ * koyup tek bir bildirim (doorbell) yazar. Tamamlanmalar MSI-X
+ * kesmesiyle, MSI-X yoksa yoklamayla işlenir. Disk "vda" adıyla
+ * blok katmanına kaydedilir.
+ */
+
+#include "system.h"
+#include "pci_driver.h"
+#include "virtio.h"
+
+#define VIRTIO_BLK_QUEUE_MAX    256
+#define VIRTIO_BLK_MAX_SECTORS  2048
+
+// Özellik bitleri
+#define VIRTIO_BLK_F_FLUSH      (1 << 9)
+
+// İstek türleri ve durum kodları
+#define VIRTIO_BLK_T_IN         0
+#define VIRTIO_BLK_T_OUT        1
+#define VIRTIO_BLK_T_FLUSH      4
+#define VIRTIO_BLK_S_OK         0
+
+typedef struct {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t sector;
+} __attribute__((packed)) virtio_blk_header_t;
+
+typedef struct {
+    bool present;
+    uint16_t io_base;
+    uint16_t queue_size;
+    uint32_t features;
+
+    uint8_t* ring;              // Sayfa ayırıcıdan, fiziksel bitişik
+    volatile vring_desc_t* desc;
+    volatile vring_avail_t* avail;
+    volatile vring_used_t* used;
+
+    uint16_t free_head;
+    uint16_t num_free;
+    uint16_t avail_idx;         // Henüz yayınlanmamış avail indeksi
+    uint16_t notified_idx;      // Aygıta son bildirilen avail indeksi
+    uint16_t last_used;
+
+    // Zincir başı tanımlayıcısına göre istek durumu
+    block_request_t* inflight[VIRTIO_BLK_QUEUE_MAX];
+    virtio_blk_header_t headers[VIRTIO_BLK_QUEUE_MAX];
+    volatile uint8_t statuses[VIRTIO_BLK_QUEUE_MAX];
+} virtio_blk_t;
+
+static virtio_blk_t vblk;
+static block_device_t virtio_blk_block;
+
+static uint16_t virtio_blk_alloc_desc(void) {
+    uint16_t index = vblk.free_head;
+    vblk.free_head = vblk.desc[index].next;
+    vblk.num_free--;
+    return index;
+}
+
+static void virtio_blk_free_chain(uint16_t head) {
+    uint16_t index = head;
+    vblk.num_free++;
+    while(vblk.desc[index].flags & VRING_DESC_F_NEXT) {
+        index = vblk.desc[index].next;
+        vblk.num_free++;
+    }
+    vblk.desc[index].next = vblk.free_head;
+    vblk.free_head = head;
+}
+
+// Zinciri kur ve avail halkasına ekle; bildirim ayrı yapılır
+static void virtio_blk_queue(block_request_t* request, uint32_t type) {
+    uint16_t head = virtio_blk_alloc_desc();
+    uint16_t tail = head;
+
+    vblk.headers[head].type = type;
+    vblk.headers[head].reserved = 0;
+    vblk.headers[head].sector = request->lba;
+    vblk.statuses[head] = 0xFF;
+    vblk.inflight[head] = request;
+
+    vblk.desc[head].addr = (uintptr_t)&vblk.headers[head];
+    vblk.desc[head].len = sizeof(virtio_blk_header_t);
+    vblk.desc[head].flags = VRING_DESC_F_NEXT;
+
+    if(request->count) {
+        uint16_t data = virtio_blk_alloc_desc();
+        vblk.desc[tail].next = data;
+        vblk.desc[data].addr = (uintptr_t)request->buffer;
+        vblk.desc[data].len = request->count * BLOCK_SECTOR_SIZE;
+        vblk.desc[data].flags = VRING_DESC_F_NEXT | (request->write ? 0 : VRING_DESC_F_WRITE);
+        tail = data;
+    }
+
+    uint16_t status = virtio_blk_alloc_desc();
+    vblk.desc[tail].next = status;
+    vblk.desc[status].addr = (uintptr_t)&vblk.statuses[head];
+    vblk.desc[status].len = 1;
+    vblk.desc[status].flags = VRING_DESC_F_WRITE;
+
+    vblk.avail->ring[vblk.avail_idx % vblk.queue_size] = head;
+    vblk.avail_idx++;
+}
+
+// Bekleyen tüm zincirleri tek seferde yayınla ve bir kez bildir
+static void virtio_blk_notify(void) {
+    if(vblk.avail_idx == vblk.notified_idx) return;
+
+    virtio_mb();
+    vblk.avail->idx = vblk.avail_idx;
+    vblk.notified_idx = vblk.avail_idx;
+    virtio_mb();
+
+    if(!(vblk.used->flags & VRING_USED_F_NO_NOTIFY)) {
+        outw(vblk.io_base + VIRTIO_PCI_QUEUE_NOTIFY, 0);
+    }
+}
+
+// Kesmeler kapalıyken çağrılır (kesme işleyicisi veya yoklama)
+static void virtio_blk_process_used(void) {
+    while(vblk.last_used != vblk.used->idx) {
+        virtio_mb();
+        volatile vring_used_elem_t* elem = &vblk.used->ring[vblk.last_used % vblk.queue_size];
+        uint16_t head = (uint16_t)elem->id;
+        block_request_t* request = vblk.inflight[head];
+
+        vblk.inflight[head] = NULL;
+        vblk.last_used++;
+        virtio_blk_free_chain(head);
+
+        request->status = vblk.statuses[head] == VIRTIO_BLK_S_OK ? 0 : -1;
+        if(request->complete) request->complete(request);
+    }
+}
+
+static void virtio_blk_irq(void) {
+    virtio_blk_process_used();
+}
+
+static void virtio_blk_poll(block_device_t *device) {
+    (void)device;
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    virtio_blk_process_used();
+    if(enabled) enable_interrupts();
+}
+
+// Kuyrukta yer kalmadıysa bekleyenleri bildir ve tamamlanma topla
+static void virtio_blk_reserve(uint16_t descriptors) {
+    while(vblk.num_free < descriptors) {
+        virtio_blk_notify();
+        virtio_blk_process_used();
+        __asm__ volatile("pause");
+    }
+}
+
+static int virtio_blk_submit(block_device_t *device, block_request_t *requests) {
+    (void)device;
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    while(requests) {
+        // complete isteği yeniden kullanabilir: sonrakini önceden al
+        block_request_t* request = requests;
+        requests = request->next;
+
+        virtio_blk_reserve(3);
+        virtio_blk_queue(request, request->write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN);
+    }
+    virtio_blk_notify();
+    if(enabled) enable_interrupts();
+    return 0;
+}
+
+static int virtio_blk_flush(block_device_t *device) {
+    if(!(vblk.features & VIRTIO_BLK_F_FLUSH)) return 0;
+
+    block_request_t request = {0};
+    request.status = BLOCK_PENDING;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    virtio_blk_reserve(2);
+    virtio_blk_queue(&request, VIRTIO_BLK_T_FLUSH);
+    virtio_blk_notify();
+    if(enabled) enable_interrupts();
+
+    block_wait(device, &request);
+    return request.status;
+}
+
+// Halka aygıtın bildirdiği boyutta ayrılır
+static bool virtio_blk_setup_ring(uint16_t size) {
+    uint32_t bytes = VRING_BYTES(size);
+    uint32_t pages = (bytes + PAGE_SIZE - 1) / PAGE_SIZE;
+    uint8_t* ring = (uint8_t*)pmm_alloc_contiguous(pages, VIRTIO_PCI_QUEUE_ALIGN, PMM_ZONE_NORMAL);
+    if(!ring) return false;
+
+    // Eski arabirimde halka 32-bit PFN ile bildirilir
+    if((uint64_t)(uintptr_t)ring / VIRTIO_PCI_QUEUE_ALIGN > 0xFFFFFFFF) {
+        pmm_free_contiguous((uintptr_t)ring, pages);
+        return false;
+    }
+    for(uint32_t i = 0; i < bytes; i++) ring[i] = 0;
+
+    vblk.ring = ring;
+    vblk.queue_size = size;
+    vblk.desc = (volatile vring_desc_t*)ring;
+    vblk.avail = (volatile vring_avail_t*)(ring + 16 * size);
+    vblk.used = (volatile vring_used_t*)(ring + VRING_USED_OFFSET(size));
+
+    for(uint16_t i = 0; i < size; i++) vblk.desc[i].next = i + 1;
+    vblk.free_head = 0;
+    vblk.num_free = size;
+    vblk.avail_idx = 0;
+    vblk.notified_idx = 0;
+    vblk.last_used = 0;
+    return true;
+}
+
+static bool virtio_blk_probe(pci_device_t *device) {
+    // Tek örnek: durum statik
+    if(vblk.present) return false;
+
+    uint64_t bar = pci_get_bar_address(device, 0);
+    if(!(device->bars[0] & PCI_ADDRESS_SPACE_IO) || !bar || bar > 0xFFFF) return false;
+
+    uint16_t io = (uint16_t)bar;
+    vblk.io_base = io;
+    pci_enable_device(device);
+    pci_set_master(device, true);
+
+    // Sıfırla, tanı ve özellikleri anlaş
+    outb(io + VIRTIO_PCI_STATUS, 0);
+    outb(io + VIRTIO_PCI_STATUS, VIRTIO_STATUS_ACKNOWLEDGE);
+    outb(io + VIRTIO_PCI_STATUS, VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER);
+    vblk.features = inl(io + VIRTIO_PCI_HOST_FEATURES) & VIRTIO_BLK_F_FLUSH;
+    outl(io + VIRTIO_PCI_GUEST_FEATURES, vblk.features);
+
+    outw(io + VIRTIO_PCI_QUEUE_SELECT, 0);
+    uint16_t size = inw(io + VIRTIO_PCI_QUEUE_SIZE);
+    if(size == 0 || size > VIRTIO_BLK_QUEUE_MAX || (size & (size - 1))) {
+        outb(io + VIRTIO_PCI_STATUS, VIRTIO_STATUS_FAILED);
+        return false;
+    }
+
+    // Kuyruk 0 tamamlanmaları MSI-X tablosunun 0. girdisine
+    bool msix = pci_setup_msix(device, 1);
+    if(msix) {
+        outw(io + VIRTIO_MSI_CONFIG_VECTOR, VIRTIO_MSI_NO_VECTOR);
+        outw(io + VIRTIO_MSI_QUEUE_VECTOR, 0);
+        if(inw(io + VIRTIO_MSI_QUEUE_VECTOR) == VIRTIO_MSI_NO_VECTOR) {
+            pci_disable_msix(device);
+            msix = false;
+        }
+    }
+    uint16_t config = io + (msix ? VIRTIO_PCI_CONFIG_MSIX : VIRTIO_PCI_CONFIG);
+
+    if(!virtio_blk_setup_ring(size)) {
+        if(msix) pci_disable_msix(device);
+        outb(io + VIRTIO_PCI_STATUS, VIRTIO_STATUS_FAILED);
+        return false;
+    }
+    outl(io + VIRTIO_PCI_QUEUE_PFN, (uint32_t)((uintptr_t)vblk.ring / VIRTIO_PCI_QUEUE_ALIGN));
+
+    if(msix) register_interrupt_handler(device->msix.base_vector, virtio_blk_irq);
+    outb(io + VIRTIO_PCI_STATUS, VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER | VIRTIO_STATUS_DRIVER_OK);
+    vblk.present = true;
+
+    virtio_blk_block.name = "vda";
+    virtio_blk_block.sectors = inl(config) | ((uint64_t)inl(config + 4) << 32);
+    virtio_blk_block.max_sectors = VIRTIO_BLK_MAX_SECTORS;
+    virtio_blk_block.queue_depth = size / 3;
+    virtio_blk_block.interrupt_driven = msix;
+    virtio_blk_block.submit = virtio_blk_submit;
+    virtio_blk_block.flush = virtio_blk_flush;
+    virtio_blk_block.poll = virtio_blk_poll;
+    virtio_blk_block.driver_data = &vblk;
+    block_register(&virtio_blk_block);
+    return true;
+}
+
+static pci_driver_t virtio_blk_driver = {
+    .name = "virtio-blk",
+    .vendor_id = VIRTIO_PCI_VENDOR,
+    .device_id = VIRTIO_PCI_DEVICE_BLK,
+    .class_code = PCI_ANY_CLASS,
+    .subclass = PCI_ANY_CLASS,
+    .prog_if = PCI_ANY_PROG_IF,
+    .probe = virtio_blk_probe,
+};
+
+void virtio_blk_init(void) {
+    pci_init();
+    pci_register_driver(&virtio_blk_driver);
+}
@@ -0,0 +1,157 @@
+; LAMAX64 OS - Uzun Kip Girişi
+; Version 1.0.0
+;
+; Shell kerneli 0x100000'e yükleyip 32-bit korumalı kipte buraya atlar.
+; Burada işlemcinin uzun kipi desteklediği doğrulanır, ilk 4 GB 2 MB'lık
+; sayfalarla birebir eşlenir, PAE + EFER.LME + CR0.PG açılır ve 64-bit kod
+; kesimine uzak atlamayla geçilir. Asıl sayfa tabloları (doğrudan eşlem,
+; vmalloc) vmm_init ile kurulur; buradakiler yalnızca oraya kadar yeter.
+;
+; Düz imaj .bss'i içermez: __bss_start..kernel_end ilk iş olarak sıfırlanır,
+; açılış tabloları ve yığın da oradadır.
+
+[BITS 32]
+
+global kernel_entry
+extern kernel_main
+extern __bss_start, kernel_end
+
+%define EFER_MSR        0xC0000080
+%define EFER_LME        (1 << 8)
+%define CR4_PAE         (1 << 5)
+%define CR0_PG          (1 << 31)
+%define PAGE_PRESENT    0x01
+%define PAGE_WRITE      0x02
+%define PAGE_HUGE       0x80
+%define BOOT_PDS        4               ; 4 x 1 GB
+%define BOOT_STACK_SIZE 0x4000
+
+section .entry progbits alloc exec nowrite align=16
+
+kernel_entry:
+    cli
+    cld
+
+    ; .bss'i sıfırla (iki uç da 4 KB hizalı)
+    mov edi, __bss_start
+    mov ecx, kernel_end
+    sub ecx, edi
+    shr ecx, 2
+    xor eax, eax
+    rep stosd
+
+    ; CPUID 0x80000001 EDX bit 29: uzun kip
+    mov eax, 0x80000000
+    cpuid
+    cmp eax, 0x80000001
+    jb .no_long_mode
+    mov eax, 0x80000001
+    cpuid
+    test edx, 1 << 29
+    jz .no_long_mode
+
+    ; Önceki aşama sayfalamayı açtıysa kapat
+    mov eax, cr0
+    and eax, ~CR0_PG & 0xFFFFFFFF
+    mov cr0, eax
+
+    ; Açılış tabloları: PML4 + PDPT + 4 PD (.bss, sıfırlandı)
+    mov dword [boot_pml4], boot_pdpt + PAGE_PRESENT + PAGE_WRITE
+    mov edi, boot_pdpt
+    mov eax, boot_pd + PAGE_PRESENT + PAGE_WRITE
+    mov ecx, BOOT_PDS
+.fill_pdpt:
+    mov [edi], eax
+    add eax, 4096
+    add edi, 8
+    loop .fill_pdpt
+
+    ; 2048 x 2 MB; PD'ler ardışık olduğu için tek döngü yeter
+    mov edi, boot_pd
+    mov eax, PAGE_PRESENT + PAGE_WRITE + PAGE_HUGE
+    mov ecx, BOOT_PDS * 512
+.fill_pd:
+    mov [edi], eax
+    add eax, 0x200000
+    add edi, 8
+    loop .fill_pd
+
+    mov eax, cr4
+    or eax, CR4_PAE
+    mov cr4, eax
+    mov eax, boot_pml4
+    mov cr3, eax
+
+    mov ecx, EFER_MSR
+    rdmsr
+    or eax, EFER_LME
+    wrmsr
+
+    mov eax, cr0
+    or eax, CR0_PG
+    mov cr0, eax
+
+    lgdt [gdt64_pointer]
+    jmp GDT64_CODE:long_mode_entry
+
+.no_long_mode:
+    mov esi, no_long_mode_msg
+    mov edi, 0xB8000
+.print:
+    lodsb
+    test al, al
+    jz .halt
+    mov ah, 0x4F
+    stosw
+    jmp .print
+.halt:
+    hlt
+    jmp .halt
+
+[BITS 64]
+
+long_mode_entry:
+    mov ax, GDT64_DATA
+    mov ds, ax
+    mov es, ax
+    mov ss, ax
+    xor ax, ax
+    mov fs, ax
+    mov gs, ax
+    mov rsp, boot_stack_top
+    xor ebp, ebp
+
+    call kernel_main
+
+.halt:
+    cli
+    hlt
+    jmp .halt
+
+; Düz GDT: boş, 64-bit kod (L=1), veri
+align 8
+gdt64:
+    dq 0
+    dq 0x00AF9A000000FFFF
+    dq 0x00CF92000000FFFF
+gdt64_end:
+
+GDT64_CODE equ 0x08
+GDT64_DATA equ 0x10
+
+gdt64_pointer:
+    dw gdt64_end - gdt64 - 1
+    dq gdt64
+
+no_long_mode_msg db "LAMAX64: CPU does not support 64-bit long mode", 0
+
+section .bss
+
+alignb 4096
+boot_pml4:  resb 4096
+boot_pdpt:  resb 4096
+boot_pd:    resb BOOT_PDS * 4096
+
+alignb 16
+boot_stack: resb BOOT_STACK_SIZE
+boot_stack_top:
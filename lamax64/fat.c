@@ -0,0 +1,515 @@
+/*
+ * LAMAX64 OS - FAT12/16/32 Dosya Sistemi
+ * Version 1.0.0
+ *
+ * Salt okunur FAT sürücüsü. Birim aygıtın başında ya da MBR'deki ilk
+ * FAT bölümündedir; tür BPB'deki küme sayısından belirlenir. FAT
+ * tablosu ve veriler tampon önbelleğinden okunur, böylece sık erişilen
+ * FAT sektörleri bellekte kalır. Küme zinciri dosya başına bir imleçle
+ * ileri yürünür; ardışık kümeler tek okumada birleşir ve ardışık
+ * okumalar önden okuma penceresini bu bitişik parçalar üzerinden açar.
+ * Uzun dosya adları (LFN) sağlama toplamıyla doğrulanıp ASCII'ye
+ * çevrilir.
+ */
+
+#include "system.h"
+
+#define FAT_MAX_VOLUMES     4
+#define FAT_SECTOR_SIZE     512
+#define FAT_DIRENT_SIZE     32
+#define FAT_EOC             0xFFFFFFFF
+
+#define FAT_ATTR_READ_ONLY  0x01
+#define FAT_ATTR_HIDDEN     0x02
+#define FAT_ATTR_SYSTEM     0x04
+#define FAT_ATTR_VOLUME_ID  0x08
+#define FAT_ATTR_DIRECTORY  0x10
+#define FAT_ATTR_LFN        0x0F
+
+// NT küçük harf bayrakları (kısa ad)
+#define FAT_CASE_LOWER_BASE 0x08
+#define FAT_CASE_LOWER_EXT  0x10
+
+#define FAT_LFN_LAST        0x40
+#define FAT_LFN_CHARS       13
+#define FAT_LFN_MAX         (MAX_FILENAME - 1)
+
+typedef struct {
+    uint8_t jump[3];
+    char oem[8];
+    uint16_t bytes_per_sector;
+    uint8_t sectors_per_cluster;
+    uint16_t reserved_sectors;
+    uint8_t fat_count;
+    uint16_t root_entries;
+    uint16_t total_sectors16;
+    uint8_t media;
+    uint16_t fat_size16;
+    uint16_t sectors_per_track;
+    uint16_t heads;
+    uint32_t hidden_sectors;
+    uint32_t total_sectors32;
+
+    // FAT32 genişletilmiş BPB
+    uint32_t fat_size32;
+    uint16_t ext_flags;
+    uint16_t version;
+    uint32_t root_cluster;
+    uint16_t fsinfo_sector;
+    uint16_t backup_boot_sector;
+} __attribute__((packed)) fat_bpb_t;
+
+typedef struct {
+    uint8_t name[11];
+    uint8_t attributes;
+    uint8_t nt_case;
+    uint8_t create_tenths;
+    uint16_t create_time;
+    uint16_t create_date;
+    uint16_t access_date;
+    uint16_t cluster_high;
+    uint16_t modify_time;
+    uint16_t modify_date;
+    uint16_t cluster_low;
+    uint32_t size;
+} __attribute__((packed)) fat_dirent_t;
+
+typedef struct {
+    uint8_t order;
+    uint16_t name1[5];
+    uint8_t attributes;
+    uint8_t type;
+    uint8_t checksum;
+    uint16_t name2[6];
+    uint16_t cluster;
+    uint16_t name3[2];
+} __attribute__((packed)) fat_lfn_t;
+
+typedef struct {
+    block_device_t* device;
+    uint64_t start;             // Birimin ilk sektörü (LBA)
+    uint8_t type;               // 12, 16 veya 32
+    uint32_t sectors_per_cluster;
+    uint32_t cluster_bytes;
+    uint32_t fat_start;         // Sektörler birime göredir
+    uint32_t root_start;        // FAT12/16 sabit kök dizin
+    uint32_t root_sectors;
+    uint32_t data_start;
+    uint32_t cluster_count;
+} fat_volume_t;
+
+// Önden okuma eşleme bağlamı: dosyanın imlecini bozmamak için kopya
+typedef struct {
+    fat_volume_t* volume;
+    file_t cursor;
+} fat_map_context_t;
+
+static fat_volume_t fat_volumes[FAT_MAX_VOLUMES];
+
+// Birim içi bayt konumundan okuma; blok sınırlarını aşabilir
+static int fat_read_volume(fat_volume_t* volume, uint64_t position, void* buffer, uint32_t size) {
+    uint8_t* out = buffer;
+    uint64_t address = volume->start * FAT_SECTOR_SIZE + position;
+
+    while(size) {
+        uint64_t block = address / BCACHE_BLOCK_SIZE;
+        uint32_t offset = (uint32_t)(address % BCACHE_BLOCK_SIZE);
+        uint32_t chunk = BCACHE_BLOCK_SIZE - offset;
+        if(chunk > size) chunk = size;
+
+        buffer_t* buffer = bcache_read(volume->device, block);
+        if(!buffer) return -1;
+        memcpy(out, buffer->data + offset, chunk);
+        bcache_release(buffer);
+
+        out += chunk;
+        address += chunk;
+        size -= chunk;
+    }
+    return 0;
+}
+
+static bool fat_cluster_valid(fat_volume_t* volume, uint32_t cluster) {
+    return cluster >= 2 && cluster < volume->cluster_count + 2;
+}
+
+static uint64_t fat_cluster_position(fat_volume_t* volume, uint32_t cluster) {
+    uint64_t sector = volume->data_start + (uint64_t)(cluster - 2) * volume->sectors_per_cluster;
+    return sector * FAT_SECTOR_SIZE;
+}
+
+// Zincirdeki sonraki küme; son, bozuk ya da okunamayan girdi FAT_EOC
+static uint32_t fat_next_cluster(fat_volume_t* volume, uint32_t cluster) {
+    uint64_t fat = (uint64_t)volume->fat_start * FAT_SECTOR_SIZE;
+    uint32_t next = 0;
+
+    if(volume->type == 12) {
+        uint16_t value;
+        if(fat_read_volume(volume, fat + cluster + cluster / 2, &value, 2) != 0) return FAT_EOC;
+        next = (cluster & 1) ? value >> 4 : value & 0x0FFF;
+    } else if(volume->type == 16) {
+        uint16_t value;
+        if(fat_read_volume(volume, fat + cluster * 2, &value, 2) != 0) return FAT_EOC;
+        next = value;
+    } else {
+        if(fat_read_volume(volume, fat + cluster * 4, &next, 4) != 0) return FAT_EOC;
+        next &= 0x0FFFFFFF;
+    }
+
+    return fat_cluster_valid(volume, next) ? next : FAT_EOC;
+}
+
+// Zincirdeki index. küme. İmleç geriye gidilmedikçe baştan yürümeyi önler.
+static uint32_t fat_cluster_at(fat_volume_t* volume, file_t* file, uint32_t index) {
+    uint32_t position = 0;
+    uint32_t cluster = (uint32_t)file->node.id;
+
+    if(file->cursor_block && file->cursor_index <= index) {
+        position = (uint32_t)file->cursor_index;
+        cluster = (uint32_t)file->cursor_block;
+    }
+    if(!fat_cluster_valid(volume, cluster)) return FAT_EOC;
+
+    while(position < index) {
+        cluster = fat_next_cluster(volume, cluster);
+        if(cluster == FAT_EOC) return FAT_EOC;
+        position++;
+    }
+
+    file->cursor_index = position;
+    file->cursor_block = cluster;
+    return cluster;
+}
+
+// cluster'dan başlayıp en çok limit kümeye kadar bitişik küme sayısı
+static uint32_t fat_contiguous(fat_volume_t* volume, file_t* file, uint32_t index, uint32_t cluster, uint32_t limit) {
+    uint32_t run = 1;
+    while(run < limit) {
+        uint32_t next = fat_cluster_at(volume, file, index + run);
+        if(next != cluster + run) break;
+        run++;
+    }
+    return run;
+}
+
+static bool fat_fixed_root(fat_volume_t* volume, file_t* file) {
+    return volume->type != 32 && file->node.is_directory && file->node.id == 0;
+}
+
+// Düğüm içeriğinden oku (dosya ya da dizin); okunan bayt sayısı döner
+static int fat_read_node(fat_volume_t* volume, file_t* file, uint32_t offset, void* buffer, uint32_t size) {
+    uint8_t* out = buffer;
+    uint32_t done = 0;
+
+    if(fat_fixed_root(volume, file)) {
+        uint32_t limit = volume->root_sectors * FAT_SECTOR_SIZE;
+        if(offset >= limit) return 0;
+        if(size > limit - offset) size = limit - offset;
+
+        uint64_t position = (uint64_t)volume->root_start * FAT_SECTOR_SIZE + offset;
+        return fat_read_volume(volume, position, out, size) == 0 ? (int)size : -1;
+    }
+
+    while(done < size) {
+        uint32_t index = offset / volume->cluster_bytes;
+        uint32_t within = offset % volume->cluster_bytes;
+        uint32_t cluster = fat_cluster_at(volume, file, index);
+        if(cluster == FAT_EOC) break;
+
+        // İstenen aralığı kapsayan bitişik kümeler tek okumada
+        uint32_t wanted = within + (size - done);
+        uint32_t clusters = (wanted + volume->cluster_bytes - 1) / volume->cluster_bytes;
+        uint32_t run = fat_contiguous(volume, file, index, cluster, clusters);
+
+        uint32_t chunk = run * volume->cluster_bytes - within;
+        if(chunk > size - done) chunk = size - done;
+
+        if(fat_read_volume(volume, fat_cluster_position(volume, cluster) + within, out + done, chunk) != 0) {
+            return done ? (int)done : -1;
+        }
+        done += chunk;
+        offset += chunk;
+    }
+    return (int)done;
+}
+
+// Dosyanın index. önbellek bloğunu aygıt bloğuna çevir; bitişik blok sayısı döner
+static uint32_t fat_readahead_map(void* context, uint64_t index, uint64_t* block) {
+    fat_map_context_t* map = context;
+    fat_volume_t* volume = map->volume;
+    uint64_t offset = index * BCACHE_BLOCK_SIZE;
+    uint32_t cluster_index = (uint32_t)div_u64(offset, volume->cluster_bytes);
+    uint32_t within = (uint32_t)(offset - (uint64_t)cluster_index * volume->cluster_bytes);
+
+    uint32_t cluster = fat_cluster_at(volume, &map->cursor, cluster_index);
+    if(cluster == FAT_EOC) return 0;
+
+    uint32_t limit = (READAHEAD_MAX_BLOCKS * BCACHE_BLOCK_SIZE) / volume->cluster_bytes + 1;
+    uint32_t run = fat_contiguous(volume, &map->cursor, cluster_index, cluster, limit);
+
+    uint64_t start = volume->start * FAT_SECTOR_SIZE + fat_cluster_position(volume, cluster) + within;
+    uint64_t end = start + (uint64_t)run * volume->cluster_bytes - within;
+    *block = start / BCACHE_BLOCK_SIZE;
+    return (uint32_t)((end - 1) / BCACHE_BLOCK_SIZE - *block + 1);
+}
+
+static int fat_read(vfs_mount_t* mount, file_t* file, void* buffer, uint32_t size) {
+    fat_volume_t* volume = mount->fs_data;
+
+    uint64_t first = file->position / BCACHE_BLOCK_SIZE;
+    uint64_t last = ((uint64_t)file->position + size - 1) / BCACHE_BLOCK_SIZE;
+    uint64_t end = ((uint64_t)file->size + BCACHE_BLOCK_SIZE - 1) / BCACHE_BLOCK_SIZE;
+
+    fat_map_context_t context;
+    context.volume = volume;
+    context.cursor = *file;
+    readahead_access(&file->readahead, volume->device, first, (uint32_t)(last - first + 1), end,
+                     fat_readahead_map, &context);
+
+    return fat_read_node(volume, file, file->position, buffer, size);
+}
+
+static uint8_t fat_lfn_checksum(const uint8_t* name) {
+    uint8_t sum = 0;
+    for(int i = 0; i < 11; i++) sum = ((sum & 1) << 7) + (sum >> 1) + name[i];
+    return sum;
+}
+
+// UCS-2 karakteri ASCII'ye; karşılığı olmayanlar '?'
+static char fat_lfn_char(uint16_t c) {
+    return c < 0x80 ? (char)c : '?';
+}
+
+static void fat_short_name(const fat_dirent_t* entry, char* name) {
+    int length = 0;
+
+    for(int i = 0; i < 8 && entry->name[i] != ' '; i++) {
+        char c = (char)entry->name[i];
+        if(i == 0 && entry->name[0] == 0x05) c = (char)0xE5;
+        if((entry->nt_case & FAT_CASE_LOWER_BASE) && c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        name[length++] = c;
+    }
+    if(entry->name[8] != ' ') {
+        name[length++] = '.';
+        for(int i = 8; i < 11 && entry->name[i] != ' '; i++) {
+            char c = (char)entry->name[i];
+            if((entry->nt_case & FAT_CASE_LOWER_EXT) && c >= 'A' && c <= 'Z') c += 'a' - 'A';
+            name[length++] = c;
+        }
+    }
+    name[length] = 0;
+}
+
+// Dizin konumundan bir sonraki geçerli girdiyi oku; 1 bulundu, 0 son, -1 hata
+static int fat_next_entry(fat_volume_t* volume, file_t* dir, vfs_dirent_t* entry, fat_dirent_t* raw) {
+    char lfn[FAT_LFN_MAX + 1];
+    uint8_t lfn_checksum = 0;
+    int lfn_expected = 0;      // Beklenen sonraki sıra numarası; 0 LFN yok
+
+    lfn[0] = 0;
+
+    for(;;) {
+        int result = fat_read_node(volume, dir, dir->position, raw, FAT_DIRENT_SIZE);
+        if(result < 0) return -1;
+        if(result < FAT_DIRENT_SIZE || raw->name[0] == 0x00) return 0;
+        dir->position += FAT_DIRENT_SIZE;
+
+        if(raw->name[0] == 0xE5) {
+            lfn_expected = 0;
+            continue;
+        }
+
+        if((raw->attributes & 0x3F) == FAT_ATTR_LFN) {
+            fat_lfn_t* part = (fat_lfn_t*)raw;
+            int order = part->order & 0x1F;
+
+            if(part->order & FAT_LFN_LAST) {
+                for(int i = 0; i <= FAT_LFN_MAX; i++) lfn[i] = 0;
+                lfn_checksum = part->checksum;
+                lfn_expected = order;
+            }
+            if(order == 0 || order != lfn_expected || part->checksum != lfn_checksum) {
+                lfn_expected = 0;
+                continue;
+            }
+
+            uint16_t chars[FAT_LFN_CHARS];
+            memcpy(chars, part->name1, sizeof(part->name1));
+            memcpy(chars + 5, part->name2, sizeof(part->name2));
+            memcpy(chars + 11, part->name3, sizeof(part->name3));
+
+            int base = (order - 1) * FAT_LFN_CHARS;
+            for(int i = 0; i < FAT_LFN_CHARS && base + i < FAT_LFN_MAX; i++) {
+                if(chars[i] == 0x0000 || chars[i] == 0xFFFF) break;
+                lfn[base + i] = fat_lfn_char(chars[i]);
+            }
+            lfn_expected = order - 1;
+            continue;
+        }
+
+        // Birim etiketini atla
+        if(raw->attributes & FAT_ATTR_VOLUME_ID) {
+            lfn_expected = 0;
+            continue;
+        }
+
+        // LFN tüm parçaları eksiksiz geldiyse ve bu girdiye aitse kullan
+        if(lfn_expected == 0 && lfn[0] && lfn_checksum == fat_lfn_checksum(raw->name)) {
+            strcpy(entry->name, lfn);
+        } else {
+            fat_short_name(raw, entry->name);
+        }
+        lfn[0] = 0;
+        lfn_expected = 0;
+
+        entry->is_directory = (raw->attributes & FAT_ATTR_DIRECTORY) != 0;
+        entry->size = entry->is_directory ? 0 : raw->size;
+        return 1;
+    }
+}
+
+static int fat_readdir(vfs_mount_t* mount, file_t* dir, vfs_dirent_t* entry) {
+    fat_volume_t* volume = mount->fs_data;
+    fat_dirent_t raw;
+
+    for(;;) {
+        int result = fat_next_entry(volume, dir, entry, &raw);
+        if(result <= 0) return result;
+
+        // "." ve ".." sözcüksel olarak VFS'de çözülür
+        if(strcmp(entry->name, ".") != 0 && strcmp(entry->name, "..") != 0) return 1;
+    }
+}
+
+static bool fat_name_equal(const char* a, const char* b) {
+    while(*a && *b) {
+        char x = *a++;
+        char y = *b++;
+        if(x >= 'a' && x <= 'z') x -= 'a' - 'A';
+        if(y >= 'a' && y <= 'z') y -= 'a' - 'A';
+        if(x != y) return false;
+    }
+    return *a == *b;
+}
+
+// LFN ve kısa ad büyük/küçük harf duyarsız karşılaştırılır
+static int fat_lookup(vfs_mount_t* mount, const vfs_node_t* dir, const char* name, vfs_node_t* node) {
+    fat_volume_t* volume = mount->fs_data;
+    file_t walker;
+    vfs_dirent_t entry;
+    fat_dirent_t raw;
+
+    memset(&walker, 0, sizeof(file_t));
+    walker.node = *dir;
+    walker.is_directory = true;
+
+    for(;;) {
+        int result = fat_next_entry(volume, &walker, &entry, &raw);
+        if(result <= 0) return -1;
+
+        char short_name[13];
+        fat_short_name(&raw, short_name);
+        if(!fat_name_equal(entry.name, name) && !fat_name_equal(short_name, name)) continue;
+
+        node->mount = mount;
+        node->id = ((uint32_t)raw.cluster_high << 16) | raw.cluster_low;
+        if(volume->type != 32) node->id &= 0xFFFF;
+        node->size = entry.size;
+        node->attributes = raw.attributes;
+        node->is_directory = entry.is_directory;
+        return 0;
+    }
+}
+
+static bool fat_valid_bpb(const fat_bpb_t* bpb, const uint8_t* sector) {
+    if(sector[510] != 0x55 || sector[511] != 0xAA) return false;
+    if(bpb->jump[0] != 0xEB && bpb->jump[0] != 0xE9) return false;
+    if(bpb->bytes_per_sector != FAT_SECTOR_SIZE) return false;
+
+    uint8_t spc = bpb->sectors_per_cluster;
+    if(spc == 0 || (spc & (spc - 1))) return false;
+    return bpb->reserved_sectors != 0 && bpb->fat_count != 0;
+}
+
+// Birimin ilk sektörünü bul: bölümsüz disk ya da MBR'de ilk FAT bölümü
+static bool fat_find_volume(block_device_t* device, uint8_t* sector, uint64_t* start) {
+    static const uint8_t fat_partition_types[] = { 0x01, 0x04, 0x06, 0x0B, 0x0C, 0x0E };
+
+    if(block_read(device, 0, 1, sector) != 0) return false;
+    if(fat_valid_bpb((fat_bpb_t*)sector, sector)) {
+        *start = 0;
+        return true;
+    }
+    if(sector[510] != 0x55 || sector[511] != 0xAA) return false;
+
+    for(int i = 0; i < 4; i++) {
+        uint8_t* entry = sector + 0x1BE + i * 16;
+        uint32_t lba = entry[8] | (entry[9] << 8) | (entry[10] << 16) | ((uint32_t)entry[11] << 24);
+        bool fat = false;
+
+        for(uint32_t t = 0; t < sizeof(fat_partition_types); t++) {
+            if(entry[4] == fat_partition_types[t]) fat = true;
+        }
+        if(!fat || lba == 0) continue;
+
+        if(block_read(device, lba, 1, sector) != 0) return false;
+        if(!fat_valid_bpb((fat_bpb_t*)sector, sector)) return false;
+        *start = lba;
+        return true;
+    }
+    return false;
+}
+
+static bool fat_mount(vfs_mount_t* mount) {
+    uint8_t sector[FAT_SECTOR_SIZE];
+    fat_volume_t* volume = NULL;
+    uint64_t start;
+
+    for(int i = 0; i < FAT_MAX_VOLUMES; i++) {
+        if(!fat_volumes[i].device) {
+            volume = &fat_volumes[i];
+            break;
+        }
+    }
+    if(!volume || !fat_find_volume(mount->device, sector, &start)) return false;
+
+    fat_bpb_t* bpb = (fat_bpb_t*)sector;
+    uint32_t total = bpb->total_sectors16 ? bpb->total_sectors16 : bpb->total_sectors32;
+    uint32_t fat_size = bpb->fat_size16 ? bpb->fat_size16 : bpb->fat_size32;
+    uint32_t root_sectors = (bpb->root_entries * FAT_DIRENT_SIZE + FAT_SECTOR_SIZE - 1) / FAT_SECTOR_SIZE;
+    uint32_t data_start = bpb->reserved_sectors + bpb->fat_count * fat_size + root_sectors;
+    if(fat_size == 0 || total <= data_start) return false;
+
+    uint32_t clusters = (total - data_start) / bpb->sectors_per_cluster;
+
+    volume->start = start;
+    volume->sectors_per_cluster = bpb->sectors_per_cluster;
+    volume->cluster_bytes = bpb->sectors_per_cluster * FAT_SECTOR_SIZE;
+    volume->fat_start = bpb->reserved_sectors;
+    volume->root_start = bpb->reserved_sectors + bpb->fat_count * fat_size;
+    volume->root_sectors = root_sectors;
+    volume->data_start = data_start;
+    volume->cluster_count = clusters;
+    volume->type = clusters < 4085 ? 12 : clusters < 65525 ? 16 : 32;
+
+    mount->root.id = volume->type == 32 ? bpb->root_cluster : 0;
+    if(volume->type == 32 && !fat_cluster_valid(volume, bpb->root_cluster)) return false;
+
+    volume->device = mount->device;
+    mount->root.size = 0;
+    mount->root.attributes = FAT_ATTR_DIRECTORY;
+    mount->fs_data = volume;
+    return true;
+}
+
+static vfs_ops_t fat_ops = {
+    .name = "fat",
+    .mount = fat_mount,
+    .lookup = fat_lookup,
+    .readdir = fat_readdir,
+    .read = fat_read,
+};
+
+void fat_init() {
+    vfs_register_filesystem(&fat_ops);
+}
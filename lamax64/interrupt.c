@@ -0,0 +1,355 @@
+/*
+ * LAMAX64 OS - Kesme Yönetimi
+ * Version 1.0.0
+ *
+ * IDT kurulumu, istisna işleme ve vektör başına işleyici tablosu.
+ * Dağıtım tablo indeksiyle O(1) yapılır. MADT yerel APIC ve IO-APIC
+ * tanımlıyorsa IRQ'lar IO-APIC üzerinden yönlendirilir; aksi halde
+ * yeniden eşlenmiş 8259 PIC kullanılır.
+ */
+
+#include "system.h"
+#include "acpi.h"
+
+// 8259 PIC portları
+#define PIC1_COMMAND        0x20
+#define PIC1_DATA           0x21
+#define PIC2_COMMAND        0xA0
+#define PIC2_DATA           0xA1
+#define PIC_EOI             0x20
+
+// Yerel APIC yazmaçları (taban adrese göre)
+#define LAPIC_ID            0x020
+#define LAPIC_TPR           0x080
+#define LAPIC_EOI           0x0B0
+#define LAPIC_SVR           0x0F0
+#define LAPIC_SVR_ENABLE    0x100
+#define IA32_APIC_BASE_MSR  0x1B
+#define IA32_APIC_ENABLE    0x800
+
+// IO-APIC yazmaçları
+#define IOAPIC_REGSEL       0x00
+#define IOAPIC_WINDOW       0x10
+#define IOAPIC_VERSION      0x01
+#define IOAPIC_REDIRECT     0x10
+#define IOAPIC_MASKED       0x10000
+#define IOAPIC_LEVEL        0x8000
+#define IOAPIC_ACTIVE_LOW   0x2000
+
+// MADT override bayrakları (MPS INTI)
+#define MPS_POLARITY_MASK   0x3
+#define MPS_POLARITY_LOW    0x3
+#define MPS_TRIGGER_MASK    0xC
+#define MPS_TRIGGER_LEVEL   0xC
+
+#define SPURIOUS_VECTOR     0xFF
+#define ISA_IRQ_COUNT       16
+
+// MSI/MSI-X: ISA IRQ'larından sonraki vektörler, yerel APIC'e mesaj
+#define MSI_VECTOR_FIRST    (IRQ_BASE + ISA_IRQ_COUNT)
+#define MSI_ADDRESS_BASE    0xFEE00000
+
+// IDT kapı tipi: 64-bit kesme kapısı, ring 0, mevcut
+#define IDT_GATE_INTERRUPT  0x8E
+#define KERNEL_CODE_SEG     0x08        // entry.asm GDT'si
+
+// IDT girişi (uzun kip, 16 bayt)
+typedef struct {
+    uint16_t offset_low;
+    uint16_t selector;
+    uint8_t ist;
+    uint8_t type_attr;
+    uint16_t offset_middle;
+    uint32_t offset_high;
+    uint32_t reserved;
+} __attribute__((packed)) idt_entry_t;
+
+typedef struct {
+    uint16_t limit;
+    uint64_t base;
+} __attribute__((packed)) idt_descriptor_t;
+
+static idt_entry_t idt[IDT_ENTRIES] __attribute__((aligned(16)));
+static void (*interrupt_handlers[IDT_ENTRIES])();
+
+// isr.asm içindeki giriş noktaları
+extern uintptr_t isr_stub_table[IDT_ENTRIES];
+
+bool interrupts_enabled = false;
+
+// APIC durumu (apic_enabled false ise PIC kullanılır)
+static bool apic_enabled = false;
+static volatile uint32_t* lapic_base = NULL;
+static volatile uint32_t* ioapic_base = NULL;
+static uint32_t ioapic_gsi_base = 0;
+static uint8_t bsp_apic_id = 0;
+static uint8_t cpu_apic_ids[MAX_CPUS];
+static int cpus_online = 1;
+static uint32_t msi_next_vector = MSI_VECTOR_FIRST;
+
+// ISA IRQ -> GSI ve yönlendirme bayrakları
+static uint32_t isa_irq_gsi[ISA_IRQ_COUNT];
+static uint32_t isa_irq_flags[ISA_IRQ_COUNT];
+
+// İşlenmekte olan istisnanın çerçevesi
+static interrupt_frame_t* current_frame = NULL;
+
+static const char* exception_names[32] = {
+    "Divide Error", "Debug", "NMI", "Breakpoint", "Overflow",
+    "BOUND Range Exceeded", "Invalid Opcode", "Device Not Available",
+    "Double Fault", "Coprocessor Segment Overrun", "Invalid TSS",
+    "Segment Not Present", "Stack-Segment Fault", "General Protection",
+    "Page Fault", "Reserved", "x87 FPU Error", "Alignment Check",
+    "Machine Check", "SIMD Floating-Point", "Virtualization",
+    "Control Protection", "Reserved", "Reserved", "Reserved", "Reserved",
+    "Reserved", "Reserved", "Hypervisor Injection", "VMM Communication",
+    "Security", "Reserved"
+};
+
+static void idt_set_gate(int vector, uintptr_t handler) {
+    idt[vector].offset_low = handler & 0xFFFF;
+    idt[vector].selector = KERNEL_CODE_SEG;
+    idt[vector].ist = 0;
+    idt[vector].type_attr = IDT_GATE_INTERRUPT;
+    idt[vector].offset_middle = (handler >> 16) & 0xFFFF;
+    idt[vector].offset_high = (uint32_t)(handler >> 32);
+    idt[vector].reserved = 0;
+}
+
+// PIC'i IRQ 0-15 -> vektör 32-47 olacak şekilde yeniden eşle
+static void pic_remap() {
+    outb(PIC1_COMMAND, 0x11);           // ICW1: başlat, ICW4 gelecek
+    outb(PIC2_COMMAND, 0x11);
+    outb(PIC1_DATA, IRQ_BASE);          // ICW2: vektör tabanı
+    outb(PIC2_DATA, IRQ_BASE + 8);
+    outb(PIC1_DATA, 0x04);              // ICW3: IRQ2'de ikincil PIC
+    outb(PIC2_DATA, 0x02);
+    outb(PIC1_DATA, 0x01);              // ICW4: 8086 modu
+    outb(PIC2_DATA, 0x01);
+
+    // IRQ2 (kademe) dışında hepsini maskele
+    outb(PIC1_DATA, 0xFB);
+    outb(PIC2_DATA, 0xFF);
+}
+
+static void pic_unmask(int irq) {
+    uint16_t port = irq < 8 ? PIC1_DATA : PIC2_DATA;
+    outb(port, inb(port) & ~(1 << (irq & 7)));
+}
+
+static inline uint32_t lapic_read(uint32_t reg) {
+    return lapic_base[reg / 4];
+}
+
+static inline void lapic_write(uint32_t reg, uint32_t value) {
+    lapic_base[reg / 4] = value;
+}
+
+static void ioapic_write(uint32_t reg, uint32_t value) {
+    ioapic_base[IOAPIC_REGSEL / 4] = reg;
+    ioapic_base[IOAPIC_WINDOW / 4] = value;
+}
+
+static uint32_t ioapic_read(uint32_t reg) {
+    ioapic_base[IOAPIC_REGSEL / 4] = reg;
+    return ioapic_base[IOAPIC_WINDOW / 4];
+}
+
+// GSI için yönlendirme girişini yaz (hedef: BSP, sabit teslim)
+static void ioapic_route(uint32_t gsi, uint8_t vector, uint32_t flags, bool masked) {
+    uint32_t pin = gsi - ioapic_gsi_base;
+    uint32_t low = vector;
+
+    if((flags & MPS_POLARITY_MASK) == MPS_POLARITY_LOW) low |= IOAPIC_ACTIVE_LOW;
+    if((flags & MPS_TRIGGER_MASK) == MPS_TRIGGER_LEVEL) low |= IOAPIC_LEVEL;
+    if(masked) low |= IOAPIC_MASKED;
+
+    ioapic_write(IOAPIC_REDIRECT + pin * 2 + 1, (uint32_t)bsp_apic_id << 24);
+    ioapic_write(IOAPIC_REDIRECT + pin * 2, low);
+}
+
+static inline uint64_t rdmsr(uint32_t msr) {
+    uint32_t low, high;
+    __asm__ volatile("rdmsr" : "=a"(low), "=d"(high) : "c"(msr));
+    return ((uint64_t)high << 32) | low;
+}
+
+static inline void wrmsr(uint32_t msr, uint64_t value) {
+    __asm__ volatile("wrmsr" : : "c"(msr), "a"((uint32_t)value), "d"((uint32_t)(value >> 32)));
+}
+
+// MADT yerel APIC ve IO-APIC tanımlıyorsa APIC moduna geç
+static bool apic_init() {
+    acpi_madt_t* madt;
+
+    if(!acpi_init()) return false;
+    madt = acpi_get_madt();
+    if(!madt || acpi_get_io_apic_count() == 0) return false;
+
+    lapic_base = (volatile uint32_t*)(uintptr_t)madt->local_apic_address;
+    ioapic_base = (volatile uint32_t*)(uintptr_t)acpi_get_io_apic_address(0);
+    ioapic_gsi_base = acpi_get_io_apic_gsib(0);
+
+    // Yerel APIC'i etkinleştir
+    wrmsr(IA32_APIC_BASE_MSR, rdmsr(IA32_APIC_BASE_MSR) | IA32_APIC_ENABLE);
+    lapic_write(LAPIC_TPR, 0);
+    lapic_write(LAPIC_SVR, LAPIC_SVR_ENABLE | SPURIOUS_VECTOR);
+    bsp_apic_id = lapic_read(LAPIC_ID) >> 24;
+    cpu_apic_ids[0] = bsp_apic_id;
+
+    // ISA IRQ'ları varsayılan olarak aynı GSI'ya, override varsa ona
+    for(int irq = 0; irq < ISA_IRQ_COUNT; irq++) {
+        isa_irq_gsi[irq] = irq;
+        isa_irq_flags[irq] = 0;
+    }
+    for(uint32_t i = 0; i < acpi_get_interrupt_override_count(); i++) {
+        uint8_t bus, source;
+        uint32_t gsi;
+        uint16_t flags;
+        if(acpi_get_interrupt_override(i, &bus, &source, &gsi, &flags) &&
+           bus == 0 && source < ISA_IRQ_COUNT) {
+            isa_irq_gsi[source] = gsi;
+            isa_irq_flags[source] = flags;
+        }
+    }
+
+    // Tüm pinleri maskeli olarak hazırla
+    uint32_t pins = ((ioapic_read(IOAPIC_VERSION) >> 16) & 0xFF) + 1;
+    for(uint32_t pin = 0; pin < pins; pin++) {
+        ioapic_route(ioapic_gsi_base + pin, SPURIOUS_VECTOR, 0, true);
+    }
+
+    // PIC artık kullanılmıyor
+    outb(PIC1_DATA, 0xFF);
+    outb(PIC2_DATA, 0xFF);
+    return true;
+}
+
+static void irq_unmask(int irq) {
+    if(!apic_enabled) {
+        pic_unmask(irq);
+        return;
+    }
+    ioapic_route(isa_irq_gsi[irq], IRQ_BASE + irq, isa_irq_flags[irq], false);
+}
+
+static void interrupt_eoi(uint32_t vector) {
+    if(apic_enabled) {
+        if(vector != SPURIOUS_VECTOR) lapic_write(LAPIC_EOI, 0);
+        return;
+    }
+    if(vector >= IRQ_BASE && vector < IRQ_BASE + ISA_IRQ_COUNT) {
+        if(vector >= IRQ_BASE + 8) outb(PIC2_COMMAND, PIC_EOI);
+        outb(PIC1_COMMAND, PIC_EOI);
+    }
+}
+
+// isr.asm tarafından donanım kesmeleri için çağrılır
+void interrupt_dispatch(uint32_t vector) {
+    void (*handler)() = interrupt_handlers[vector];
+    bool enabled = interrupts_enabled;
+
+    // İşleyici IF=0 ile çalışır; içindeki kaydet/geri yükle çiftleri
+    // (tamamlanma geri çağrıları gibi) STI yapmasın
+    interrupts_enabled = false;
+    if(handler) handler();
+    interrupt_eoi(vector);
+    interrupts_enabled = enabled;
+}
+
+// isr.asm tarafından istisnalar için çağrılır
+void exception_dispatch(interrupt_frame_t* frame) {
+    void (*handler)() = interrupt_handlers[frame->vector];
+
+    current_frame = frame;
+    if(handler) {
+        handler();
+        current_frame = NULL;
+        return;
+    }
+
+    kprintf("\nEXCEPTION %u (%s) error=%x\n", (uint32_t)frame->vector,
+            exception_names[frame->vector], (uint32_t)frame->error_code);
+    kprintf("RIP=%016llx CS=%04x RFLAGS=%08x\n", frame->rip, (uint32_t)frame->cs, (uint32_t)frame->rflags);
+    kprintf("RAX=%016llx RBX=%016llx RCX=%016llx\n", frame->rax, frame->rbx, frame->rcx);
+    kprintf("RDX=%016llx RSI=%016llx RDI=%016llx\n", frame->rdx, frame->rsi, frame->rdi);
+    kprintf("RBP=%016llx RSP=%016llx\n", frame->rbp, frame->rsp);
+    PANIC("Unhandled CPU exception");
+}
+
+interrupt_frame_t* interrupt_current_frame() {
+    return current_frame;
+}
+
+void interrupt_init() {
+    idt_descriptor_t descriptor;
+
+    for(int i = 0; i < IDT_ENTRIES; i++) {
+        idt_set_gate(i, isr_stub_table[i]);
+    }
+
+    // APIC kullanılsa bile PIC yeniden eşlenir: sahte IRQ'lar
+    // istisna vektörlerine düşmesin
+    pic_remap();
+    apic_enabled = apic_init();
+
+    descriptor.limit = sizeof(idt) - 1;
+    descriptor.base = (uintptr_t)idt;
+    __asm__ volatile("lidt %0" : : "m"(descriptor));
+}
+
+bool interrupt_apic_enabled() {
+    return apic_enabled;
+}
+
+// MSI için count ardışık vektör ayır; APIC yoksa ya da yer kalmadıysa 0
+int interrupt_alloc_vectors(int count) {
+    if(!apic_enabled || count <= 0 || msi_next_vector + count > SPURIOUS_VECTOR) return 0;
+
+    int vector = msi_next_vector;
+    msi_next_vector += count;
+    return vector;
+}
+
+// MSI adres/veri çifti: cpu'ya sabit teslim, kenar tetiklemeli
+void interrupt_msi_message(uint8_t vector, int cpu, uint32_t* address, uint32_t* data) {
+    uint8_t apic_id = (cpu > 0 && cpu < cpus_online) ? cpu_apic_ids[cpu] : bsp_apic_id;
+
+    *address = MSI_ADDRESS_BASE | ((uint32_t)apic_id << 12);
+    *data = vector;
+}
+
+int cpu_count() {
+    return cpus_online;
+}
+
+// Çalışan işlemcinin sırası (0 = BSP); APIC yoksa tek işlemci
+int cpu_current() {
+    if(!apic_enabled || cpus_online == 1) return 0;
+
+    uint8_t apic_id = lapic_read(LAPIC_ID) >> 24;
+    for(int cpu = 0; cpu < cpus_online; cpu++) {
+        if(cpu_apic_ids[cpu] == apic_id) return cpu;
+    }
+    return 0;
+}
+
+// İşleyiciyi kaydet; ISA IRQ'su ise PIC/IO-APIC'te maskesini kaldır
+void register_interrupt_handler(int interrupt, void (*handler)()) {
+    if(interrupt < 0 || interrupt >= IDT_ENTRIES) return;
+
+    interrupt_handlers[interrupt] = handler;
+    if(interrupt >= IRQ_BASE && interrupt < IRQ_BASE + ISA_IRQ_COUNT) {
+        irq_unmask(interrupt - IRQ_BASE);
+    }
+}
+
+void enable_interrupts() {
+    interrupts_enabled = true;
+    STI();
+}
+
+void disable_interrupts() {
+    CLI();
+    interrupts_enabled = false;
+}
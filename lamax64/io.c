@@ -0,0 +1,45 @@
+/*
+ * LAMAX64 OS - Port I/O
+ * Version 1.0.0
+ */
+
+#include "system.h"
+
+uint8_t inb(uint16_t port) {
+    uint8_t data;
+    __asm__ volatile("inb %1, %0" : "=a"(data) : "Nd"(port));
+    return data;
+}
+
+void outb(uint16_t port, uint8_t data) {
+    __asm__ volatile("outb %0, %1" : : "a"(data), "Nd"(port));
+}
+
+uint16_t inw(uint16_t port) {
+    uint16_t data;
+    __asm__ volatile("inw %1, %0" : "=a"(data) : "Nd"(port));
+    return data;
+}
+
+void outw(uint16_t port, uint16_t data) {
+    __asm__ volatile("outw %0, %1" : : "a"(data), "Nd"(port));
+}
+
+uint32_t inl(uint16_t port) {
+    uint32_t data;
+    __asm__ volatile("inl %1, %0" : "=a"(data) : "Nd"(port));
+    return data;
+}
+
+void outl(uint16_t port, uint32_t data) {
+    __asm__ volatile("outl %0, %1" : : "a"(data), "Nd"(port));
+}
+
+// Bir porttan count adet 16-bit kelimeyi tampona oku (PIO veri transferi)
+void insw(uint16_t port, void* buffer, uint32_t count) {
+    __asm__ volatile("rep insw" : "+D"(buffer), "+c"(count) : "d"(port) : "memory");
+}
+
+void outsw(uint16_t port, const void* buffer, uint32_t count) {
+    __asm__ volatile("rep outsw" : "+S"(buffer), "+c"(count) : "d"(port) : "memory");
+}
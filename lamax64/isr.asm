@@ -0,0 +1,144 @@
+; LAMAX64 OS - Kesme Giriş Noktaları
+; Version 1.0.0
+;
+; İstisnalar (0-31) tüm yazmaçları kaydeder ve exception_dispatch'e bir
+; çerçeve işaretçisi verir. Donanım kesmeleri (32-255) sık geldiği için
+; sadece System V çağrı kuralının bozabileceği yazmaçları (RAX, RCX, RDX,
+; RSI, RDI, R8-R11) saklar; diğerlerini interrupt_dispatch zaten korur.
+; İki yolda da çağrı anında RSP 16 bayta hizalıdır (işlemci girişte
+; hizalar, sonra çift sayıda sözcük itilir).
+
+[BITS 64]
+
+global isr_stub_table
+extern interrupt_dispatch
+extern exception_dispatch
+
+section .text
+
+; CPU hata kodu koymuyorsa sahte 0 koy
+%macro EXCEPTION_NOERR 1
+isr_stub_%1:
+    push qword 0
+    push qword %1
+    jmp exception_common
+%endmacro
+
+%macro EXCEPTION_ERR 1
+isr_stub_%1:
+    push qword %1
+    jmp exception_common
+%endmacro
+
+EXCEPTION_NOERR 0
+EXCEPTION_NOERR 1
+EXCEPTION_NOERR 2
+EXCEPTION_NOERR 3
+EXCEPTION_NOERR 4
+EXCEPTION_NOERR 5
+EXCEPTION_NOERR 6
+EXCEPTION_NOERR 7
+EXCEPTION_ERR   8
+EXCEPTION_NOERR 9
+EXCEPTION_ERR   10
+EXCEPTION_ERR   11
+EXCEPTION_ERR   12
+EXCEPTION_ERR   13
+EXCEPTION_ERR   14
+EXCEPTION_NOERR 15
+EXCEPTION_NOERR 16
+EXCEPTION_ERR   17
+EXCEPTION_NOERR 18
+EXCEPTION_NOERR 19
+EXCEPTION_NOERR 20
+EXCEPTION_ERR   21
+EXCEPTION_NOERR 22
+EXCEPTION_NOERR 23
+EXCEPTION_NOERR 24
+EXCEPTION_NOERR 25
+EXCEPTION_NOERR 26
+EXCEPTION_NOERR 27
+EXCEPTION_NOERR 28
+EXCEPTION_ERR   29
+EXCEPTION_ERR   30
+EXCEPTION_NOERR 31
+
+exception_common:
+    push rax
+    push rbx
+    push rcx
+    push rdx
+    push rsi
+    push rdi
+    push rbp
+    push r8
+    push r9
+    push r10
+    push r11
+    push r12
+    push r13
+    push r14
+    push r15
+    cld
+    mov rdi, rsp            ; interrupt_frame_t*
+    call exception_dispatch
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop r11
+    pop r10
+    pop r9
+    pop r8
+    pop rbp
+    pop rdi
+    pop rsi
+    pop rdx
+    pop rcx
+    pop rbx
+    pop rax
+    add rsp, 16             ; vektör + hata kodu
+    iretq
+
+; Donanım ve yazılım kesmeleri (vektör 32-255)
+%assign vector 32
+%rep 224
+isr_stub_ %+ vector:
+    push rax
+    mov eax, vector
+    jmp isr_common
+%assign vector vector + 1
+%endrep
+
+isr_common:
+    push rcx
+    push rdx
+    push rsi
+    push rdi
+    push r8
+    push r9
+    push r10
+    push r11
+    cld
+    mov edi, eax            ; vektör numarası
+    call interrupt_dispatch
+    pop r11
+    pop r10
+    pop r9
+    pop r8
+    pop rdi
+    pop rsi
+    pop rdx
+    pop rcx
+    pop rax
+    iretq
+
+section .rodata
+
+; Tüm vektörlerin giriş adresleri
+isr_stub_table:
+%assign vector 0
+%rep 256
+    dq isr_stub_ %+ vector
+%assign vector vector + 1
+%endrep
@@ -0,0 +1,150 @@
+/*
+ * LAMAX64 OS - PS/2 Klavye Sürücüsü
+ * Version 1.0.0
+ *
+ * IRQ1 işleyicisi tarama kodlarını tek üretici / tek tüketicili bir
+ * halka tampona yazar. Okuyucu tampon boşken HLT ile bekler, böylece
+ * CPU yoklama döngüsünde dönmez. Kernelin boşta döngüsü burası olduğu
+ * için ertelenmiş işler (keyboard_set_idle) HLT'den önce çalışır.
+ */
+
+#include "system.h"
+
+#define KEYBOARD_DATA_PORT  0x60
+#define KEYBOARD_IRQ        1
+
+// Tarama kodu tamponu (256 bayt, indeksler uint8_t ile sarılır)
+#define KEYBOARD_BUFFER_SIZE 256
+
+static volatile uint8_t keyboard_buffer[KEYBOARD_BUFFER_SIZE];
+static volatile uint8_t keyboard_head = 0;   // Sadece IRQ yazar
+static volatile uint8_t keyboard_tail = 0;   // Sadece okuyucu yazar
+static volatile uint32_t keyboard_dropped = 0;
+static void (*keyboard_idle)() = NULL;
+
+// Değiştirici tuş durumu
+static bool keyboard_shift = false;
+static bool keyboard_extended = false;
+
+// Scancode set 1 -> ASCII (küçük harf / shift)
+static const char keymap_normal[128] = {
+    0, 27, '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '-', '=', '\b',
+    '\t', 'q', 'w', 'e', 'r', 't', 'y', 'u', 'i', 'o', 'p', '[', ']', '\n',
+    0, 'a', 's', 'd', 'f', 'g', 'h', 'j', 'k', 'l', ';', '\'', '`',
+    0, '\\', 'z', 'x', 'c', 'v', 'b', 'n', 'm', ',', '.', '/', 0,
+    '*', 0, ' '
+};
+
+static const char keymap_shift[128] = {
+    0, 27, '!', '@', '#', '$', '%', '^', '&', '*', '(', ')', '_', '+', '\b',
+    '\t', 'Q', 'W', 'E', 'R', 'T', 'Y', 'U', 'I', 'O', 'P', '{', '}', '\n',
+    0, 'A', 'S', 'D', 'F', 'G', 'H', 'J', 'K', 'L', ':', '"', '~',
+    0, '|', 'Z', 'X', 'C', 'V', 'B', 'N', 'M', '<', '>', '?', 0,
+    '*', 0, ' '
+};
+
+#define SC_LEFT_SHIFT       0x2A
+#define SC_RIGHT_SHIFT      0x36
+#define SC_EXTENDED         0xE0
+#define SC_PAGE_UP          0x49
+#define SC_PAGE_DOWN        0x51
+#define SC_RELEASE          0x80
+
+// IRQ1: tarama kodunu oku ve tampona ekle (üretici)
+static void keyboard_irq() {
+    uint8_t scancode = inb(KEYBOARD_DATA_PORT);
+    uint8_t head = keyboard_head;
+
+    if((uint8_t)(head + 1) == keyboard_tail) {
+        keyboard_dropped++;
+        return;
+    }
+    keyboard_buffer[head] = scancode;
+    __asm__ volatile("" : : : "memory");    // Veri, indeksten önce yazılsın
+    keyboard_head = head + 1;
+}
+
+void keyboard_init() {
+    keyboard_head = keyboard_tail = 0;
+    register_interrupt_handler(IRQ_BASE + KEYBOARD_IRQ, keyboard_irq);
+}
+
+// Tampon boşken, kesmeler açık çağrılır (kesme bağlamında yapılamayan işler)
+void keyboard_set_idle(void (*idle)()) {
+    keyboard_idle = idle;
+}
+
+// Bir tarama kodu al; tampon boşsa kesme gelene kadar HLT ile bekle
+static uint8_t keyboard_read_scancode() {
+    for(;;) {
+        if(keyboard_idle && keyboard_tail == keyboard_head) keyboard_idle();
+        CLI();
+        if(keyboard_tail != keyboard_head) break;
+        // STI'den sonraki komut kesmeye kapalıdır: STI; HLT arasında
+        // gelen kesme kaçırılmaz
+        __asm__ volatile("sti; hlt");
+    }
+    uint8_t scancode = keyboard_buffer[keyboard_tail];
+    keyboard_tail++;
+    STI();
+    return scancode;
+}
+
+// Bir karakter oku (tüketici). Sayfa tuşları konsol geçmişini kaydırır.
+char keyboard_getc() {
+    for(;;) {
+        uint8_t scancode = keyboard_read_scancode();
+
+        if(scancode == SC_EXTENDED) {
+            keyboard_extended = true;
+            continue;
+        }
+        if(keyboard_extended) {
+            keyboard_extended = false;
+            if(scancode == SC_PAGE_UP) console_page_up();
+            else if(scancode == SC_PAGE_DOWN) console_page_down();
+            continue;
+        }
+
+        bool released = (scancode & SC_RELEASE) != 0;
+        scancode &= ~SC_RELEASE;
+
+        if(scancode == SC_LEFT_SHIFT || scancode == SC_RIGHT_SHIFT) {
+            keyboard_shift = !released;
+            continue;
+        }
+        if(released) continue;
+
+        char c = keyboard_shift ? keymap_shift[scancode] : keymap_normal[scancode];
+        if(c) return c;
+    }
+}
+
+// Satır düzenleyici: yankı, geri silme; Enter ile biter
+int keyboard_readline(char* buffer, int max_len) {
+    int len = 0;
+
+    for(;;) {
+        char c = keyboard_getc();
+
+        if(c == '\n') break;
+        if(c == '\b') {
+            if(len > 0) {
+                len--;
+                console_backspace();
+            }
+            continue;
+        }
+        if(len < max_len && c >= ' ') {
+            char echo[2] = { c, 0 };
+            buffer[len++] = c;
+            kprint(echo);
+        }
+    }
+    buffer[len] = 0;
+    return len;
+}
+
+uint32_t keyboard_dropped_count() {
+    return keyboard_dropped;
+}
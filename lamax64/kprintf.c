@@ -0,0 +1,184 @@
+/*
+ * LAMAX64 OS - Biçimli Çıktı (kprintf / ksnprintf)
+ * Version 1.0.0
+ *
+ * Desteklenen biçimler: %s %c %d %i %u %x %X %p %% ve l/ll uzunlukları.
+ * Bayraklar: '-' (sola yasla), '0' (sıfırla doldur), genişlik.
+ */
+
+#include "system.h"
+
+// kprintf'in yığındaki tampon boyutu
+#define KPRINTF_BUFFER_SIZE 256
+
+// Biçimleme çıkışı: tampon dolunca flush (varsa) çağrılır
+typedef struct format_out {
+    char* buffer;
+    uint32_t size;
+    uint32_t pos;
+    uint32_t total;
+    void (*flush)(struct format_out* out);
+} format_out_t;
+
+static void out_char(format_out_t* out, char c) {
+    if(out->pos >= out->size) {
+        if(!out->flush) { out->total++; return; }
+        out->flush(out);
+    }
+    out->buffer[out->pos++] = c;
+    out->total++;
+}
+
+static void out_padding(format_out_t* out, char c, int count) {
+    while(count-- > 0) out_char(out, c);
+}
+
+// 64-bit sayıyı 10'a böl, kalanı döndür (libgcc __udivdi3 olmadan)
+static uint32_t divmod10_u64(uint64_t* value) {
+    uint64_t n = *value;
+    uint64_t q = 0;
+    uint32_t rem = 0;
+
+    // 16-bit parçalarla uzun bölme, ara değerler 32-bit'e sığar
+    for(int shift = 48; shift >= 0; shift -= 16) {
+        uint32_t cur = (rem << 16) | (uint32_t)((n >> shift) & 0xFFFF);
+        q |= (uint64_t)(cur / 10) << shift;
+        rem = cur % 10;
+    }
+    *value = q;
+    return rem;
+}
+
+static void out_number(format_out_t* out, uint64_t value, int base, bool upper,
+                       bool negative, int width, bool left, bool zero) {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[24];
+    int len = 0;
+
+    do {
+        if(base == 16) {
+            tmp[len++] = digits[value & 0xF];
+            value >>= 4;
+        } else {
+            tmp[len++] = digits[divmod10_u64(&value)];
+        }
+    } while(value);
+
+    int pad = width - len - (negative ? 1 : 0);
+    if(!left && !zero) out_padding(out, ' ', pad);
+    if(negative) out_char(out, '-');
+    if(!left && zero) out_padding(out, '0', pad);
+    while(len) out_char(out, tmp[--len]);
+    if(left) out_padding(out, ' ', pad);
+}
+
+static void format(format_out_t* out, const char* fmt, va_list args) {
+    while(*fmt) {
+        if(*fmt != '%') {
+            out_char(out, *fmt++);
+            continue;
+        }
+        fmt++;
+
+        bool left = false, zero = false;
+        int width = 0, longs = 0;
+
+        for(;; fmt++) {
+            if(*fmt == '-') left = true;
+            else if(*fmt == '0') zero = true;
+            else break;
+        }
+        while(*fmt >= '0' && *fmt <= '9') {
+            width = width * 10 + (*fmt++ - '0');
+        }
+        while(*fmt == 'l') { longs++; fmt++; }
+
+        switch(*fmt) {
+            case 's': {
+                const char* s = va_arg(args, const char*);
+                if(!s) s = "(null)";
+                int len = strlen(s);
+                if(!left) out_padding(out, ' ', width - len);
+                while(*s) out_char(out, *s++);
+                if(left) out_padding(out, ' ', width - len);
+                break;
+            }
+            case 'c':
+                if(!left) out_padding(out, ' ', width - 1);
+                out_char(out, (char)va_arg(args, int));
+                if(left) out_padding(out, ' ', width - 1);
+                break;
+            case 'd':
+            case 'i': {
+                int64_t v = longs >= 2 ? va_arg(args, int64_t)
+                          : longs == 1 ? va_arg(args, long) : va_arg(args, int);
+                bool negative = v < 0;
+                out_number(out, negative ? 0 - (uint64_t)v : (uint64_t)v, 10, false,
+                           negative, width, left, zero);
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X': {
+                uint64_t v = longs >= 2 ? va_arg(args, uint64_t)
+                           : longs == 1 ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+                out_number(out, v, *fmt == 'u' ? 10 : 16, *fmt == 'X',
+                           false, width, left, zero);
+                break;
+            }
+            case 'p':
+                out_char(out, '0');
+                out_char(out, 'x');
+                out_number(out, (uint64_t)(uintptr_t)va_arg(args, void*), 16, false,
+                           false, sizeof(void*) * 2, false, true);
+                break;
+            case '%':
+                out_char(out, '%');
+                break;
+            case 0:
+                return;
+            default:
+                out_char(out, '%');
+                out_char(out, *fmt);
+                break;
+        }
+        fmt++;
+    }
+}
+
+// Tampona yaz, sonuç her zaman NUL ile biter. Yazılması gereken
+// toplam uzunluğu döndürür (tampon küçükse çıktı kesilir).
+int kvsnprintf(char* buffer, uint32_t size, const char* fmt, va_list args) {
+    format_out_t out = { buffer, size ? size - 1 : 0, 0, 0, NULL };
+    format(&out, fmt, args);
+    if(size) buffer[out.pos] = 0;
+    return (int)out.total;
+}
+
+int ksnprintf(char* buffer, uint32_t size, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int len = kvsnprintf(buffer, size, fmt, args);
+    va_end(args);
+    return len;
+}
+
+// Dolan yığın tamponunu konsola aktar (ekrana çizmeden)
+static void kprintf_spill(format_out_t* out) {
+    console_write(out->buffer, out->pos);
+    out->pos = 0;
+}
+
+// Çıktıyı yığındaki tamponda biçimle, konsola tek seferde yaz
+void kprintf(const char* fmt, ...) {
+    char buffer[KPRINTF_BUFFER_SIZE];
+    format_out_t out = { buffer, sizeof(buffer), 0, 0, kprintf_spill };
+    va_list args;
+
+    va_start(args, fmt);
+    format(&out, fmt, args);
+    va_end(args);
+
+    console_write(buffer, out.pos);
+    console_flush();
+}
@@ -1,16 +1,26 @@
-*
+/*
  * LAMAX64 Operating System Kernel
  * Version 1.0.0
  * A Unix-like 64-bit operating system with hybrid Windows/Linux commands
  */
 
 #include "system.h"
+#include "ata.h"
+#include "virtio.h"
+#include "nvme.h"
 
-// VGA ekran tamponu
-volatile char* vga_buffer = (volatile char*)0xB8000;
-int cursor_x = 0, cursor_y = 0;
 char current_path[256] = "/";
 
+// Konsol geçmişi: ekran + CONSOLE_HISTORY_LINES satır
+static uint16_t console_history[CONSOLE_HISTORY_LINES + VGA_HEIGHT][VGA_WIDTH] __attribute__((aligned(4)));
+
+// Açılış profili aşama adları (BOOT_MARK_* sırası)
+static const char* boot_mark_names[] = {
+    "mbr.start", "mbr.disk_read", "mbr.loaded", "disk.main", "disk.shell_loaded",
+    "shell.main", "shell.kernel_loaded", "kernel.main", "kernel.console",
+    "kernel.interrupts", "kernel.timer", "kernel.init_done", "kernel.prompt"
+};
+
 // String fonksiyonları
 int strcmp(const char* str1, const char* str2) {
     while(*str1 && (*str1 == *str2)) {
@@ -37,58 +47,28 @@ int strncmp(const char* str1, const char* str2, int n) {
     return n < 0 ? 0 : *str1 - *str2;
 }
 
-// Basit ekran çıktısı
-void kprint(const char* str) {
-    while(*str) {
-        if(*str == '\n') {
-            cursor_x = 0; cursor_y++;
-        } else {
-            int index = (cursor_y * 80 + cursor_x) * 2;
-            vga_buffer[index] = *str;
-            vga_buffer[index + 1] = 0x07;
-            cursor_x++;
-        }
-        str++;
-        if(cursor_x >= 80) { cursor_x = 0; cursor_y++; }
-        if(cursor_y >= 25) {
-            cursor_y = 24;
-            for(int i = 0; i < 24 * 80; i++) {
-                vga_buffer[i * 2] = vga_buffer[(i + 80) * 2];
-                vga_buffer[i * 2 + 1] = vga_buffer[(i + 80) * 2 + 1];
-            }
-            for(int i = 24 * 80; i < 25 * 80; i++) {
-                vga_buffer[i * 2] = ' ';
-                vga_buffer[i * 2 + 1] = 0x07;
-            }
-        }
-    }
+// Bellek fonksiyonları
+void* memset(void* dest, int value, uint32_t count) {
+    uint8_t* d = dest;
+    while(count--) *d++ = (uint8_t)value;
+    return dest;
 }
 
-void kprint_colored(const char* str, char color) {
-    char old_attr = 0x07;
-    while(*str) {
-        if(*str == '\n') {
-            cursor_x = 0; cursor_y++;
-        } else {
-            int index = (cursor_y * 80 + cursor_x) * 2;
-            vga_buffer[index] = *str;
-            vga_buffer[index + 1] = color;
-            cursor_x++;
-        }
-        str++;
-        if(cursor_x >= 80) { cursor_x = 0; cursor_y++; }
-        if(cursor_y >= 25) {
-            cursor_y = 24;
-            for(int i = 0; i < 24 * 80; i++) {
-                vga_buffer[i * 2] = vga_buffer[(i + 80) * 2];
-                vga_buffer[i * 2 + 1] = vga_buffer[(i + 80) * 2 + 1];
-            }
-            for(int i = 24 * 80; i < 25 * 80; i++) {
-                vga_buffer[i * 2] = ' ';
-                vga_buffer[i * 2 + 1] = 0x07;
-            }
-        }
+void* memcpy(void* dest, const void* src, uint32_t count) {
+    uint8_t* d = dest;
+    const uint8_t* s = src;
+    while(count--) *d++ = *s++;
+    return dest;
+}
+
+int memcmp(const void* ptr1, const void* ptr2, uint32_t count) {
+    const uint8_t* a = ptr1;
+    const uint8_t* b = ptr2;
+    while(count--) {
+        if(*a != *b) return *a - *b;
+        a++; b++;
     }
+    return 0;
 }
 
 // Kernel komutları (Windows/Linux karışımı)
@@ -103,12 +83,24 @@ void cmd_help() {
     kprint("  cp / copy    - Copy files\n");
     kprint("  mv / move    - Move/rename files\n");
     kprint("  rm / del     - Delete files\n");
-    kprint("  cat / type   - Display file contents\n\n");
+    kprint("  cat / type   - Display file contents\n");
+    kprint("  echo         - Print text (echo <text> [> or >> file])\n\n");
     
     kprint_colored("System Commands:\n", 0x0B);
     kprint("  ps           - List running processes\n");
     kprint("  top          - Show system performance\n");
     kprint("  clear / cls  - Clear screen\n");
+    kprint("  console      - Select output (vga/serial/all)\n");
+    kprint("  bootprof     - Boot time profile per stage\n");
+    kprint("  lsblk        - List block devices\n");
+    kprint("  mount        - List mounted file systems\n");
+    kprint("  meminfo      - Physical memory map, zones and paging\n");
+    kprint("  slabinfo     - Kernel object caches\n");
+    kprint("  kmbench      - kmalloc/kfree timing (kmbench [size])\n");
+    kprint("  bcache       - Buffer cache statistics\n");
+    kprint("  dcache       - Dentry cache statistics\n");
+    kprint("  blkread      - Sequential read test (blkread <dev> [MB])\n");
+    kprint("  sync         - Write dirty buffers to disk\n");
     kprint("  date         - Show system date/time\n");
     kprint("  uname        - System information\n");
     kprint("  ver          - System version\n");
@@ -122,34 +114,200 @@ void cmd_help() {
     kprint("  ipconfig     - Network configuration\n\n");
 }
 
+static uint32_t boot_cycles_to_us(uint64_t cycles) {
+    return (uint32_t)div_u64(tsc_to_ns(cycles), 1000);
+}
+
+// Açılış profili: ekrana tablo, seri porta test betikleri için
+// "BOOTPROF <tür> <ad> <us>" satırları
+void boot_profile_print(bool serial) {
+    volatile boot_profile_t* profile = (volatile boot_profile_t*)BOOT_PROFILE_ADDR;
+    char line[96];
+    int len;
+
+    if(profile->magic != BOOT_PROFILE_MAGIC || !tsc_frequency()) {
+        if(!serial) kprint_colored("Boot profile not available\n", 0x0C);
+        return;
+    }
+
+    uint64_t start = profile->marks[BOOT_MARK_MBR_START];
+    uint64_t last = start;
+    uint32_t count = sizeof(boot_mark_names) / sizeof(boot_mark_names[0]);
+
+    if(!serial) kprint_colored("Stage                  since MBR     delta\n", 0x0E);
+    for(uint32_t id = 0; id < BOOT_MARK_COUNT; id++) {
+        uint64_t tsc = profile->marks[id];
+        if(!tsc) continue;
+
+        const char* name = id < count ? boot_mark_names[id] : "mark";
+        uint32_t since = boot_cycles_to_us(tsc - start);
+        uint32_t delta = boot_cycles_to_us(tsc - last);
+        last = tsc;
+
+        if(serial) {
+            len = ksnprintf(line, sizeof(line), "BOOTPROF mark %s %u\n", name, since);
+            serial_write(line, len);
+        } else {
+            kprintf("  %-20s %8u us %8u us\n", name, since, delta);
+        }
+    }
+
+    // MBR'nin BIOS okuması da disk süresine sayılır
+    uint64_t disk = profile->disk_cycles;
+    if(profile->marks[BOOT_MARK_MBR_LOADED] && profile->marks[BOOT_MARK_MBR_DISK]) {
+        disk += profile->marks[BOOT_MARK_MBR_LOADED] - profile->marks[BOOT_MARK_MBR_DISK];
+    }
+
+    uint64_t total = last - start;
+    uint64_t accounted = disk + profile->delay_cycles + profile->console_cycles;
+    uint64_t other = total > accounted ? total - accounted : 0;
+
+    const char* names[] = { "disk", "delay", "console", "other", "total" };
+    uint64_t cycles[] = { disk, profile->delay_cycles, profile->console_cycles, other, total };
+
+    if(!serial) kprint_colored("\nBreakdown:\n", 0x0E);
+    for(int i = 0; i < 5; i++) {
+        if(serial) {
+            len = ksnprintf(line, sizeof(line), "BOOTPROF time %s %u\n", names[i], boot_cycles_to_us(cycles[i]));
+            serial_write(line, len);
+        } else {
+            kprintf("  %-20s %8u us\n", names[i], boot_cycles_to_us(cycles[i]));
+        }
+    }
+    if(serial) serial_flush();
+}
+
 void cmd_clear() {
-    for(int i = 0; i < 80 * 25; i++) {
-        vga_buffer[i * 2] = ' ';
-        vga_buffer[i * 2 + 1] = 0x07;
+    console_clear();
+}
+
+// Göreli yolu geçerli dizine göre tam yola çevir
+static void shell_path(const char* arg, char* out) {
+    int length = 0;
+
+    if(arg[0] != '/') {
+        strcpy(out, current_path);
+        length = strlen(out);
     }
-    cursor_x = 0; cursor_y = 0;
+    while(*arg && length < MAX_PATH_LENGTH - 1) out[length++] = *arg++;
+    out[length] = 0;
 }
 
 void cmd_ls() {
+    file_t* dir = open_file(current_path);
+    if(!dir || !dir->is_directory) {
+        close_file(dir);
+        kprint_colored("ls: cannot open directory ", 0x0C);
+        kprint_colored(current_path, 0x0C);
+        kprint("\n");
+        return;
+    }
+
     kprint_colored("Directory listing for ", 0x07);
     kprint_colored(current_path, 0x0E);
     kprint(":\n\n");
-    kprint_colored("drwxr-xr-x  2 root root  4096 Sep 02 2025 ", 0x0B);
-    kprint("bin/\n");
-    kprint_colored("drwxr-xr-x  2 root root  4096 Sep 02 2025 ", 0x0B);
-    kprint("etc/\n");
-    kprint_colored("drwxr-xr-x  2 root root  4096 Sep 02 2025 ", 0x0B);
-    kprint("home/\n");
-    kprint_colored("drwxr-xr-x  2 root root  4096 Sep 02 2025 ", 0x0B);
-    kprint("kernel/\n");
-    kprint_colored("drwxr-xr-x  2 root root  4096 Sep 02 2025 ", 0x0B);
-    kprint("usr/\n");
-    kprint_colored("drwxr-xr-x  2 root root  4096 Sep 02 2025 ", 0x0B);
-    kprint("var/\n");
-    kprint_colored("-rw-r--r--  1 root root  1024 Sep 02 2025 ", 0x07);
-    kprint("readme.txt\n");
-    kprint_colored("-rwxr-xr-x  1 root root  8192 Sep 02 2025 ", 0x0A);
-    kprint("lamax64-1.0.0\n");
+
+    vfs_dirent_t entry;
+    while(read_directory(dir, &entry) > 0) {
+        if(entry.is_directory) {
+            kprint_colored("drwxr-xr-x  root root            ", 0x0B);
+            kprint(entry.name);
+            kprint("/\n");
+        } else {
+            kprintf("-rw-r--r--  root root %10u ", entry.size);
+            kprint(entry.name);
+            kprint("\n");
+        }
+    }
+    close_file(dir);
+}
+
+// Dosyayı parça parça konsola yaz
+void cmd_cat(const char* filename) {
+    char path[MAX_PATH_LENGTH];
+    char buffer[513];
+    int count;
+
+    shell_path(filename, path);
+    file_t* file = open_file(path);
+    if(!file || file->is_directory) {
+        close_file(file);
+        kprintf("cat: %s: No such file\n", filename);
+        return;
+    }
+
+    while((count = read_file(file, buffer, sizeof(buffer) - 1)) > 0) {
+        buffer[count] = 0;
+        kprint(buffer);
+    }
+    if(count < 0) kprint_colored("\ncat: read error\n", 0x0C);
+    close_file(file);
+}
+
+// Yolu çözüp dizinse geçerli dizin yap; yol sonu her zaman '/'
+void cmd_cd(const char* arg) {
+    char path[MAX_PATH_LENGTH];
+    char normalized[MAX_PATH_LENGTH];
+    vfs_node_t node;
+
+    shell_path(arg, path);
+    if(!vfs_normalize_path(path, normalized) || vfs_resolve(normalized, &node) != 0) {
+        kprintf("cd: %s: No such directory\n", arg);
+        return;
+    }
+    if(!node.is_directory) {
+        kprintf("cd: %s: Not a directory\n", arg);
+        return;
+    }
+
+    int length = strlen(normalized);
+    if(length + 2 > (int)sizeof(current_path)) {
+        kprintf("cd: %s: Path too long\n", arg);
+        return;
+    }
+    strcpy(current_path, normalized);
+    if(current_path[length - 1] != '/') {
+        current_path[length] = '/';
+        current_path[length + 1] = 0;
+    }
+}
+
+// Metni yaz; "> dosya" üzerine yazar, ">> dosya" sona ekler
+void cmd_echo(const char* args) {
+    char text[MAX_PATH_LENGTH];
+    char path[MAX_PATH_LENGTH];
+    int length = 0;
+
+    while(*args && *args != '>' && length < (int)sizeof(text) - 2) text[length++] = *args++;
+    while(length > 0 && text[length - 1] == ' ') length--;
+    text[length++] = '\n';
+    text[length] = 0;
+
+    if(*args != '>') {
+        kprint(text);
+        return;
+    }
+
+    bool append = args[1] == '>';
+    args += append ? 2 : 1;
+    while(*args == ' ') args++;
+    if(!*args) {
+        kprint_colored("Usage: echo <text> > file\n", 0x0C);
+        return;
+    }
+
+    shell_path(args, path);
+    if(!append) delete_file(path);
+    file_t* file = create_file(path);
+    if(!file || file->is_directory) {
+        close_file(file);
+        kprintf("echo: cannot write %s\n", args);
+        return;
+    }
+
+    if(append) file->position = file->size;
+    if(write_file(file, text, length) != length) kprintf("echo: %s: write error\n", args);
+    close_file(file);
 }
 
 void cmd_pwd() {
@@ -181,7 +339,11 @@ void cmd_ps() {
 void cmd_top() {
     kprint_colored("LAMAX64 System Monitor:\n\n", 0x0E);
     kprint("CPU Usage:    31 purna\n");
-    kprint("Memory:       bu os o kadar gelismis degil\n");
+    pmm_stats_t memory;
+    pmm_get_stats(&memory);
+    uint32_t total = memory.total_pages[PMM_ZONE_DMA] + memory.total_pages[PMM_ZONE_NORMAL];
+    uint32_t free = memory.free_pages[PMM_ZONE_DMA] + memory.free_pages[PMM_ZONE_NORMAL];
+    kprintf("Memory:       %u KB used / %u KB\n", (total - free) * (PAGE_SIZE / 1024), total * (PAGE_SIZE / 1024));
     kprint("Uptime:       reis bu komutu 2.0.0 da gir\n");
     kprint("Processes:    2.0.0 da gelecek valla\n");
     kprint("Load average: 2.0.0 da gelecek\n");
@@ -200,6 +362,186 @@ void cmd_ipconfig() {
     kprint("      TX packets:0 errors:0 dropped:0 overruns:0 carrier:0\n");
 }
 
+void cmd_lsblk() {
+    kprint_colored("Block Devices:\n\n", 0x0E);
+    kprint("NAME     SIZE(MB)  MODE    DEPTH  REQS      MERGED\n");
+    for(block_device_t* device = block_first(); device; device = device->next) {
+        block_queue_t* queue = &device->queue;
+        kprintf("%-8s %8u  %-6s  %5u  %-8u  %u\n", device->name, (uint32_t)(device->sectors >> 11),
+                device->interrupt_driven ? "irq" : "polled", queue->depth, queue->submitted, queue->merged);
+    }
+}
+
+void cmd_meminfo() {
+    static const char* types[] = {"?", "usable", "reserved", "ACPI", "ACPI NVS", "bad"};
+    const e820_map_t* map = pmm_memory_map();
+    pmm_stats_t stats;
+    pmm_get_stats(&stats);
+
+    kprint_colored("Memory map (E820):\n\n", 0x0E);
+    for(int i = 0; i < map->count; i++) {
+        const e820_entry_t* entry = &map->entries[i];
+        uint64_t end = entry->base + entry->length - 1;
+        kprintf("  %016llx-%016llx  %s\n", entry->base, end, types[entry->type <= E820_BAD ? entry->type : 0]);
+    }
+
+    kprintf("\nInstalled:    %u MB\n\n", (uint32_t)(stats.installed >> 20));
+
+    // Derece başına boş blok; parçalanma: en büyük bloğa yetmeyen boş bellek
+    static const char* zones[] = {"DMA", "Normal"};
+    kprint_colored("Zone     free KB   blocks per order 0..10                  frag\n", 0x0E);
+    for(int zone = 0; zone < PMM_ZONES; zone++) {
+        uint32_t free = stats.free_pages[zone];
+        uint32_t largest = stats.free_blocks[zone][PMM_MAX_ORDER] << PMM_MAX_ORDER;
+        kprintf("%-8s %7u  ", zones[zone], free * (PAGE_SIZE / 1024));
+        for(int order = 0; order <= PMM_MAX_ORDER; order++) kprintf(" %u", stats.free_blocks[zone][order]);
+        kprintf("  %u%%\n", free ? (free - largest) * 100 / free : 0);
+    }
+
+    vmm_stats_t paging;
+    vmm_get_stats(&paging);
+    kprint_colored("\nPaging:\n", 0x0E);
+    kprintf("  Direct map:   %016llx-%016llx, %s pages%s\n", VMM_DIRECT_BASE,
+            VMM_DIRECT_BASE + paging.mapped_limit - 1, paging.direct_page_size == 0x40000000 ? "1 GB" : "2 MB",
+            paging.global_pages ? ", global" : "");
+    kprintf("  vmalloc:      %u areas, %u KB, %u table pages\n", paging.vmalloc_areas,
+            paging.vmalloc_pages * (PAGE_SIZE / 1024), paging.table_pages);
+    kprintf("  TLB flushes:  %llu invlpg, %llu full\n", paging.invlpg_count, paging.full_flushes);
+}
+
+void cmd_slabinfo() {
+    kprint_colored("Cache            size  active  cached   total  slabs  pages  depot xchg\n", 0x0E);
+    for(kmem_cache_t* cache = kmem_cache_first(); cache; cache = cache->next) {
+        kprintf("%-14s %6u %7u %7u %7u %6u %6u  %u\n", cache->name, cache->object_size, cache->active_objects,
+                kmem_cache_cached(cache), cache->slabs * cache->objects_per_slab, cache->slabs, 1u << cache->order,
+                cache->depot_exchanges);
+    }
+}
+
+// Ayırma+bırakma çifti başına süre. Küçük yığın yerel dergilerde kalır,
+// orta boy depoyla değiş tokuş eder, büyüğü slab katmanına iner.
+#define KMBENCH_OBJECTS     4096
+#define KMBENCH_PAIRS       65536
+
+void cmd_kmbench(const char* args) {
+    static void* objects[KMBENCH_OBJECTS];
+    static const uint32_t batches[] = {16, 256, KMBENCH_OBJECTS};
+
+    uint32_t size = 0;
+    while(*args == ' ') args++;
+    while(*args >= '0' && *args <= '9') size = size * 10 + (*args++ - '0');
+    if(size == 0) size = 64;
+
+    kprintf("kmalloc(%u) + kfree on CPU %d of %d\n", size, cpu_current(), cpu_count());
+    for(uint32_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+        uint32_t batch = batches[i];
+        uint32_t failed = 0;
+
+        uint64_t start = ktime_ns();
+        for(uint32_t round = 0; round < KMBENCH_PAIRS / batch; round++) {
+            for(uint32_t j = 0; j < batch; j++) {
+                objects[j] = kmalloc(size);
+                if(!objects[j]) failed++;
+            }
+            for(uint32_t j = 0; j < batch; j++) kfree(objects[j]);
+        }
+        uint64_t elapsed = ktime_ns() - start;
+
+        kprintf("  batch %4u: %u ns per pair", batch, (uint32_t)div_u64(elapsed, KMBENCH_PAIRS));
+        if(failed) kprintf(" (%u failed)", failed);
+        kprint("\n");
+    }
+}
+
+void cmd_mount() {
+    vfs_mount_t* mount;
+
+    for(int i = 0; (mount = vfs_get_mount(i)) != NULL; i++) {
+        kprintf("%-8s on %-10s type %s\n", mount->device ? mount->device->name : "none", mount->path,
+                mount->ops->name);
+    }
+
+    uint32_t pages, nodes;
+    tmpfs_usage(&pages, &nodes);
+    kprintf("\ntmpfs: %u KB, %u nodes\n", pages * (PAGE_SIZE / 1024), nodes);
+}
+
+void cmd_dcache() {
+    dcache_stats_t stats;
+    dcache_get_stats(&stats);
+
+    uint32_t lookups = stats.hits + stats.negative_hits + stats.misses;
+    uint32_t served = stats.hits + stats.negative_hits;
+    kprint_colored("Dentry Cache:\n\n", 0x0E);
+    kprintf("Entries:      %u / %u\n", stats.entries, DCACHE_ENTRIES);
+    kprintf("Hits:         %u (%u%%)\n", stats.hits, lookups ? served * 100 / lookups : 0);
+    kprintf("Negative:     %u\n", stats.negative_hits);
+    kprintf("Misses:       %u\n", stats.misses);
+    kprintf("Evictions:    %u\n", stats.evictions);
+}
+
+void cmd_bcache() {
+    bcache_stats_t stats;
+    bcache_get_stats(&stats);
+
+    uint32_t lookups = stats.hits + stats.misses;
+    kprint_colored("Buffer Cache:\n\n", 0x0E);
+    kprintf("Blocks:       %u x %u KB\n", BCACHE_BLOCKS, BCACHE_BLOCK_SIZE / 1024);
+    kprintf("Hits:         %u (%u%%)\n", stats.hits, lookups ? stats.hits * 100 / lookups : 0);
+    kprintf("Misses:       %u\n", stats.misses);
+    kprintf("Evictions:    %u\n", stats.evictions);
+    kprintf("Dirty:        %u\n", stats.dirty);
+    kprintf("Writebacks:   %u (%u errors)\n", stats.writebacks, stats.write_errors);
+    kprintf("Readahead:    %u blocks\n", stats.readahead);
+}
+
+// Aygıtı baştan sona 16 KB'lık parçalarla oku (dosya okuyucusu gibi)
+void cmd_blkread(const char* args) {
+    char name[16];
+    int length = 0;
+
+    while(*args == ' ') args++;
+    while(*args && *args != ' ' && length < (int)sizeof(name) - 1) name[length++] = *args++;
+    name[length] = '\0';
+
+    uint32_t megabytes = 0;
+    while(*args == ' ') args++;
+    while(*args >= '0' && *args <= '9') megabytes = megabytes * 10 + (*args++ - '0');
+    if(megabytes == 0) megabytes = 16;
+
+    block_device_t* device = block_find(name);
+    if(!device) {
+        kprintf("blkread: %s: no such device\n", name);
+        return;
+    }
+
+    uint64_t end = (device->sectors + BCACHE_BLOCK_SECTORS - 1) / BCACHE_BLOCK_SECTORS;
+    uint64_t blocks = (uint64_t)megabytes * (1024 * 1024 / BCACHE_BLOCK_SIZE);
+    if(blocks > end) blocks = end;
+
+    readahead_t ra;
+    readahead_init(&ra);
+    uint64_t start = ktime_ns();
+    for(uint64_t block = 0; block < blocks; block += READAHEAD_MIN_BLOCKS) {
+        uint32_t count = blocks - block < READAHEAD_MIN_BLOCKS ? (uint32_t)(blocks - block) : READAHEAD_MIN_BLOCKS;
+        readahead_access(&ra, device, block, count, end, readahead_map_linear, NULL);
+
+        for(uint32_t i = 0; i < count; i++) {
+            buffer_t* buffer = bcache_read(device, block + i);
+            if(!buffer) {
+                kprintf("blkread: read error at block %u\n", (uint32_t)(block + i));
+                return;
+            }
+            bcache_release(buffer);
+        }
+    }
+
+    uint32_t elapsed_us = (uint32_t)div_u64(ktime_ns() - start, 1000);
+    uint32_t kilobytes = (uint32_t)(blocks * (BCACHE_BLOCK_SIZE / 1024));
+    kprintf("%s: %u KB in %u us (%u KB/s)\n", name, kilobytes, elapsed_us,
+            elapsed_us ? (uint32_t)div_u64((uint64_t)kilobytes * 1000000, elapsed_us) : 0);
+}
+
 void cmd_shutdown() {
     kprint_colored("System is shutting down...\n", 0x0C);
     kprint("Stopping services...\n");
@@ -245,9 +587,39 @@ void execute_command(const char* cmd) {
     else if(strcmp(cmd, "date") == 0) {
         cmd_date();
     }
+    else if(strcmp(cmd, "bootprof") == 0) {
+        boot_profile_print(false);
+    }
     else if(strcmp(cmd, "ipconfig") == 0) {
         cmd_ipconfig();
     }
+    else if(strcmp(cmd, "lsblk") == 0) {
+        cmd_lsblk();
+    }
+    else if(strcmp(cmd, "meminfo") == 0) {
+        cmd_meminfo();
+    }
+    else if(strcmp(cmd, "slabinfo") == 0) {
+        cmd_slabinfo();
+    }
+    else if(strcmp(cmd, "kmbench") == 0 || strncmp(cmd, "kmbench ", 8) == 0) {
+        cmd_kmbench(cmd + 7);
+    }
+    else if(strcmp(cmd, "mount") == 0) {
+        cmd_mount();
+    }
+    else if(strncmp(cmd, "blkread ", 8) == 0) {
+        cmd_blkread(cmd + 8);
+    }
+    else if(strcmp(cmd, "bcache") == 0) {
+        cmd_bcache();
+    }
+    else if(strcmp(cmd, "dcache") == 0) {
+        cmd_dcache();
+    }
+    else if(strcmp(cmd, "sync") == 0) {
+        if(bcache_sync(NULL) != 0) kprint_colored("sync: write error\n", 0x0C);
+    }
     else if(strcmp(cmd, "shutdown") == 0) {
         cmd_shutdown();
     }
@@ -259,32 +631,31 @@ void execute_command(const char* cmd) {
         // Gerçek implementasyonda shell'e geri dön
     }
     else if(strncmp(cmd, "cd ", 3) == 0) {
-        const char* path = cmd + 3;
-        kprint_colored("Changing directory to: ", 0x07);
-        kprint(path);
-        kprint("\n");
-        if(strlen(path) > 0 && strlen(path) < 200) {
-            strcpy(current_path, path);
-            if(current_path[strlen(current_path)-1] != '/') {
-                int len = strlen(current_path);
-                current_path[len] = '/';
-                current_path[len+1] = 0;
-            }
-        }
+        cmd_cd(cmd + 3);
+    }
+    else if(strncmp(cmd, "console ", 8) == 0) {
+        const char* target = cmd + 8;
+        if(strcmp(target, "vga") == 0) console_select_sinks(CONSOLE_SINK_VGA);
+        else if(strcmp(target, "serial") == 0) console_select_sinks(CONSOLE_SINK_SERIAL);
+        else if(strcmp(target, "all") == 0) console_select_sinks(CONSOLE_SINK_VGA | CONSOLE_SINK_SERIAL);
+        else kprint_colored("Usage: console vga|serial|all\n", 0x0C);
     }
     else if(strncmp(cmd, "mkdir ", 6) == 0) {
-        const char* dirname = cmd + 6;
-        kprint_colored("Creating directory: ", 0x0A);
-        kprint(dirname);
-        kprint("\n");
+        char path[MAX_PATH_LENGTH];
+        shell_path(cmd + 6, path);
+        if(!create_directory(path)) kprintf("mkdir: cannot create directory %s\n", cmd + 6);
+    }
+    else if(strncmp(cmd, "rm ", 3) == 0 || strncmp(cmd, "del ", 4) == 0 || strncmp(cmd, "rmdir ", 6) == 0) {
+        const char* filename = cmd + (cmd[0] == 'd' ? 4 : cmd[2] == ' ' ? 3 : 6);
+        char path[MAX_PATH_LENGTH];
+        shell_path(filename, path);
+        if(!delete_file(path)) kprintf("rm: cannot remove %s\n", filename);
+    }
+    else if(strncmp(cmd, "echo ", 5) == 0) {
+        cmd_echo(cmd + 5);
     }
     else if(strncmp(cmd, "cat ", 4) == 0 || strncmp(cmd, "type ", 5) == 0) {
-        const char* filename = (cmd[0] == 'c') ? cmd + 4 : cmd + 5;
-        kprint_colored("Displaying file: ", 0x07);
-        kprint(filename);
-        kprint("\n");
-        kprint_colored("This is a sample file content.\n", 0x0F);
-        kprint("LAMAX64 OS file system simulation.\n");
+        cmd_cat((cmd[0] == 'c') ? cmd + 4 : cmd + 5);
     }
     else if(strncmp(cmd, "ping ", 5) == 0) {
         const char* host = cmd + 5;
@@ -308,38 +679,34 @@ void execute_command(const char* cmd) {
     }
 }
 
-// Basit input simülasyonu (gerçek implementasyonda keyboard handler kullanılır)
+// Klavyeden bir komut satırı oku (IRQ1 sürücüsü, boşta HLT)
 void get_kernel_input(char* buffer, int max_len) {
-    // Demo amaçlı önceden tanımlı komutlar
-    static int demo_step = 0;
-    const char* demo_commands[] = {
-        "help",
-        "uname",
-        "ls",
-        "pwd",
-        "ps",
-        "top",
-        "date",
-        "clear",
-        "ver",
-        ""
-    };
-    
-    if(demo_step < 9) {
-        strcpy(buffer, demo_commands[demo_step]);
-        demo_step++;
-    } else {
-        strcpy(buffer, "help");
-        demo_step = 0;
-    }
+    keyboard_readline(buffer, max_len);
 }
 
 // Ana kernel entry point
 void kernel_main() {
     char input[128];
     
-    // Ekranı temizle
-    cmd_clear();
+    boot_profile_mark(BOOT_MARK_KERNEL_MAIN);
+    
+    // Konsolu başlat ve ekranı temizle
+    console_init(0x07);
+    console_set_history(console_history, CONSOLE_HISTORY_LINES + VGA_HEIGHT);
+    
+    // Seri konsol (COM1) ve açılış hedef seçimi
+    serial_console_init();
+    console_select_sinks(KERNEL_CONSOLE_SINKS);
+    boot_profile_mark(BOOT_MARK_CONSOLE_READY);
+    
+    // Kesmeler, zamanlayıcı ve klavye
+    interrupt_init();
+    boot_profile_mark(BOOT_MARK_IRQ_READY);
+    timer_init();
+    boot_profile_mark(BOOT_MARK_TIMER_READY);
+    keyboard_init();
+    serial_irq_init();
+    enable_interrupts();
     
     // Kernel başlangıç mesajı
     kprint_colored("================================================================\n", 0x0F);
@@ -353,54 +720,86 @@ void kernel_main() {
     
     // Sistem başlatma simülasyonu
     kprint("- Memory management: ");
-    for(volatile int i = 0; i < 1000000; i++) {} // Gecikme
+    vmm_init();
+    pmm_init();
+    kmalloc_init();
     kprint_colored("OK\n", 0x0A);
+    pmm_stats_t memory;
+    pmm_get_stats(&memory);
+    kprintf("  %u MB installed, %u MB free\n", (uint32_t)(memory.installed >> 20),
+            (memory.free_pages[PMM_ZONE_DMA] + memory.free_pages[PMM_ZONE_NORMAL]) / (1024 * 1024 / PAGE_SIZE));
+    vmm_stats_t paging;
+    vmm_get_stats(&paging);
+    kprintf("  4-level paging, %u GB direct map with %s pages\n", (uint32_t)(paging.mapped_limit >> 30),
+            paging.direct_page_size == 0x40000000 ? "1 GB" : "2 MB");
     
     kprint("- Process scheduler: ");
-    for(volatile int i = 0; i < 1000000; i++) {}
     kprint_colored("OK\n", 0x0A);
     
     kprint("- File system: ");
-    for(volatile int i = 0; i < 1000000; i++) {}
+    bcache_init();
+    keyboard_set_idle(bcache_idle);
+    dcache_init();
+    fat_init();
+    lamaxfs_init();
+    tmpfs_init();
     kprint_colored("OK\n", 0x0A);
     
     kprint("- Network stack: ");
-    for(volatile int i = 0; i < 1000000; i++) {}
     kprint_colored("OK\n", 0x0A);
     
     kprint("- Device drivers: ");
-    for(volatile int i = 0; i < 1000000; i++) {}
+    ata_device_t* boot_disk = ide_init();
+    virtio_blk_init();
+    nvme_init();
     kprint_colored("OK\n", 0x0A);
+    if(boot_disk) {
+        kprintf("  ata0: %s, %u MB%s\n", boot_disk->model, (uint32_t)(boot_disk->sectors >> 11),
+                boot_disk->dma ? ", bus-master DMA" : ", PIO");
+    }
+    block_device_t* vda = block_find("vda");
+    if(vda) {
+        kprintf("  vda: virtio-blk, %u MB%s\n", (uint32_t)(vda->sectors >> 11),
+                vda->interrupt_driven ? ", MSI-X" : ", polled");
+    }
+    block_device_t* nvme = block_find("nvme0n1");
+    if(nvme) {
+        kprintf("  nvme0n1: NVMe, %u MB%s\n", (uint32_t)(nvme->sectors >> 11),
+                nvme->interrupt_driven ? ", MSI-X" : ", polled");
+    }
+
+    // Kök dosya sistemi: tanınan ilk blok aygıtı
+    for(block_device_t* device = block_first(); device; device = device->next) {
+        if(vfs_mount("/", NULL, device) == 0) {
+            kprintf("  /: %s on %s\n", vfs_get_mount(0)->ops->name, device->name);
+            break;
+        }
+    }
+
+    // Geçici dosyalar bellekte
+    if(vfs_mount("/tmp", "tmpfs", NULL) == 0 && vfs_mount("/var", "tmpfs", NULL) == 0) {
+        kprint("  /tmp, /var: tmpfs\n");
+    }
     
     kprint("\n");
     kprint_colored("System initialization complete!\n", 0x0B);
+    boot_profile_mark(BOOT_MARK_INIT_DONE);
     kprint_colored("Welcome to LAMAX64 - Type 'help' for available commands\n\n", 0x0F);
     
+    // İlk istemde profili kapat ve seri porta dök
+    boot_profile_finish();
+    boot_profile_print(true);
+    
     // Ana kernel döngüsü
-    int demo_count = 0;
-    while(demo_count < 10) { // Demo için sınırlı döngü
+    while(1) {
         kprint_colored("root@lamax64:", 0x0A);
         kprint_colored(current_path, 0x0B);
         kprint_colored("# ", 0x0A);
         
         get_kernel_input(input, 127);
-        kprint(input);
         kprint("\n");
         
         execute_command(input);
         kprint("\n");
-        
-        demo_count++;
-        
-        // Gecikme
-        for(volatile int i = 0; i < 3000000; i++) {}
     }
-    
-    // Demo bitişi
-    kprint_colored("\n=== LAMAX64 OS Demo Complete ===\n", 0x0E);
-    kprint("This was a demonstration of the LAMAX64 operating system.\n");
-    kprint("In a real implementation, the system would continue running.\n");
-    kprint_colored("System halted.\n", 0x0C);
-    
-    while(1) {} // Sistem durdur
 }
@@ -0,0 +1,964 @@
+/*
+ * LAMAX64 OS - LAMAXFS Dosya Sistemi
+ * Version 1.0.0
+ *
+ * Yerel okuma/yazma dosya sistemi (disk düzeni lamaxfs.h'de). Tüm
+ * bloklar tampon önbelleğinden geçer; fs bloğu önbellek bloğuyla aynı
+ * boyuttadır (4 KB), birim aygıtın başındadır.
+ *
+ * Dosyalar extent listesidir: okuma bir extent'in kalanını tek parçada
+ * önden okumaya verir, büyüyen dosya son extent'in hemen ardından yer
+ * ister ve extent'i uzatır. Boş alan bitmap'te tutulur; bitmap'ten
+ * toplanan boş aralıklar küçük bir önbellekte bekler, böylece çoğu
+ * ayırma bitmap taranmadan yapılır.
+ *
+ * Dizinler doğrusal karma tablosudur: ad karması tek bir kovayı seçer,
+ * arama yalnızca o kovanın bloğunu (ve varsa taşma zincirini) okur.
+ * Ortalama doluluk sınırı aşılınca bir sonraki kova ikiye bölünür; dizin
+ * hiçbir zaman tamamen yeniden karılmaz.
+ *
+ * Açık dosyalar inode numarasını tutar: açık bir dosya silinirse girdisi
+ * hemen kalkar, blokları ve inode'u ise son kapanışta bırakılır. Arada
+ * sistem kapanırsa inode links 0 ile sahipsiz kalır.
+ */
+
+#include "system.h"
+#include "lamaxfs.h"
+
+#define LAMAXFS_MAX_VOLUMES     4
+#define LAMAXFS_FREE_CACHE      32
+#define LAMAXFS_DIR_PREALLOC    8       // Dizin bu kadar blokluk adımlarla büyür
+
+// Açık inode: silinmişse son kapanışta serbest bırakılır
+typedef struct lamaxfs_open {
+    uint32_t inode;
+    uint32_t count;
+    bool unlinked;
+    struct lamaxfs_open* next;
+} lamaxfs_open_t;
+
+typedef struct {
+    block_device_t* device;
+    lamaxfs_super_t super;
+    uint32_t inode_hint;        // Boş inode aramasının başlangıcı
+    uint32_t scan_cursor;       // Bitmap taramasının kaldığı blok
+
+    // Bitmap'te boş olduğu bilinen aralıklar
+    lamaxfs_extent_t free_cache[LAMAXFS_FREE_CACHE];
+    uint32_t free_count;
+
+    lamaxfs_open_t* opens;
+} lamaxfs_volume_t;
+
+// Önden okuma eşleme bağlamı
+typedef struct {
+    lamaxfs_volume_t* volume;
+    lamaxfs_inode_t* inode;
+} lamaxfs_map_context_t;
+
+static lamaxfs_volume_t lamaxfs_volumes[LAMAXFS_MAX_VOLUMES];
+
+static int lamaxfs_write_super(lamaxfs_volume_t* volume) {
+    buffer_t* buffer = bcache_read(volume->device, 0);
+    if(!buffer) return -1;
+
+    memcpy(buffer->data, &volume->super, sizeof(lamaxfs_super_t));
+    bcache_dirty(buffer);
+    bcache_release(buffer);
+    return 0;
+}
+
+static int lamaxfs_inode_io(lamaxfs_volume_t* volume, uint32_t number, lamaxfs_inode_t* inode, bool write) {
+    if(number == 0 || number >= volume->super.inode_count) return -1;
+
+    uint32_t block = volume->super.inode_start + number / LAMAXFS_INODES_PER_BLOCK;
+    uint32_t offset = (number % LAMAXFS_INODES_PER_BLOCK) * LAMAXFS_INODE_SIZE;
+    buffer_t* buffer = bcache_read(volume->device, block);
+    if(!buffer) return -1;
+
+    if(write) {
+        memcpy(buffer->data + offset, inode, sizeof(lamaxfs_inode_t));
+        bcache_dirty(buffer);
+    } else {
+        memcpy(inode, buffer->data + offset, sizeof(lamaxfs_inode_t));
+    }
+    bcache_release(buffer);
+    return 0;
+}
+
+static int lamaxfs_read_inode(lamaxfs_volume_t* volume, uint32_t number, lamaxfs_inode_t* inode) {
+    return lamaxfs_inode_io(volume, number, inode, false);
+}
+
+static int lamaxfs_write_inode(lamaxfs_volume_t* volume, uint32_t number, lamaxfs_inode_t* inode) {
+    return lamaxfs_inode_io(volume, number, inode, true);
+}
+
+// Bitmap: 1 kullanımda, 0 boş; okunamazsa -1
+static int lamaxfs_bitmap_test(lamaxfs_volume_t* volume, uint32_t block) {
+    buffer_t* buffer = bcache_read(volume->device, volume->super.bitmap_start + block / LAMAXFS_BITS_PER_BLOCK);
+    if(!buffer) return -1;
+
+    uint32_t bit = block % LAMAXFS_BITS_PER_BLOCK;
+    int used = (buffer->data[bit / 8] >> (bit % 8)) & 1;
+    bcache_release(buffer);
+    return used;
+}
+
+static int lamaxfs_bitmap_set(lamaxfs_volume_t* volume, uint32_t start, uint32_t count, bool used) {
+    while(count) {
+        buffer_t* buffer = bcache_read(volume->device, volume->super.bitmap_start + start / LAMAXFS_BITS_PER_BLOCK);
+        if(!buffer) return -1;
+
+        uint32_t bit = start % LAMAXFS_BITS_PER_BLOCK;
+        while(count && bit < LAMAXFS_BITS_PER_BLOCK) {
+            if(used) buffer->data[bit / 8] |= 1 << (bit % 8);
+            else buffer->data[bit / 8] &= ~(1 << (bit % 8));
+            bit++;
+            start++;
+            count--;
+        }
+        bcache_dirty(buffer);
+        bcache_release(buffer);
+    }
+    return 0;
+}
+
+// [from, to) aralığındaki boş blok aralıklarını önbellek dolana kadar topla
+static void lamaxfs_scan(lamaxfs_volume_t* volume, uint32_t from, uint32_t to) {
+    uint32_t block = from;
+    uint32_t run = 0;
+
+    while(block < to && volume->free_count < LAMAXFS_FREE_CACHE) {
+        buffer_t* buffer = bcache_read(volume->device, volume->super.bitmap_start + block / LAMAXFS_BITS_PER_BLOCK);
+        if(!buffer) return;
+
+        uint32_t bit = block % LAMAXFS_BITS_PER_BLOCK;
+        while(bit < LAMAXFS_BITS_PER_BLOCK && block < to) {
+            // Tamamen dolu baytları atla
+            if(run == 0 && bit % 8 == 0 && buffer->data[bit / 8] == 0xFF && block + 8 <= to) {
+                bit += 8;
+                block += 8;
+                continue;
+            }
+
+            if(!((buffer->data[bit / 8] >> (bit % 8)) & 1)) {
+                run++;
+            } else if(run) {
+                volume->free_cache[volume->free_count].start = block - run;
+                volume->free_cache[volume->free_count].length = run;
+                volume->free_count++;
+                run = 0;
+                if(volume->free_count == LAMAXFS_FREE_CACHE) break;
+            }
+            bit++;
+            block++;
+        }
+        bcache_release(buffer);
+    }
+
+    if(run && volume->free_count < LAMAXFS_FREE_CACHE) {
+        volume->free_cache[volume->free_count].start = block - run;
+        volume->free_cache[volume->free_count].length = run;
+        volume->free_count++;
+    }
+    volume->scan_cursor = block < volume->super.block_count ? block : volume->super.data_start;
+}
+
+static void lamaxfs_refill(lamaxfs_volume_t* volume) {
+    uint32_t cursor = volume->scan_cursor;
+
+    lamaxfs_scan(volume, cursor, volume->super.block_count);
+    if(volume->free_count < LAMAXFS_FREE_CACHE && cursor > volume->super.data_start) {
+        lamaxfs_scan(volume, volume->super.data_start, cursor);
+    }
+}
+
+// Ayrılan aralığı bitmap'e işle ve önbellekteki örtüşen aralıklardan çıkar
+static void lamaxfs_take(lamaxfs_volume_t* volume, uint32_t start, uint32_t length) {
+    uint32_t end = start + length;
+
+    lamaxfs_bitmap_set(volume, start, length, true);
+    volume->super.free_blocks -= length;
+
+    for(uint32_t i = 0; i < volume->free_count; i++) {
+        lamaxfs_extent_t* free = &volume->free_cache[i];
+        uint32_t free_end = free->start + free->length;
+        if(free_end <= start || free->start >= end) continue;
+
+        if(free->start >= start && free_end <= end) {
+            free->length = 0;
+        } else if(free->start >= start) {
+            free->length = free_end - end;
+            free->start = end;
+        } else {
+            // Baştaki parça kalır; ortadan ayrıldıysa kuyruk yer varsa eklenir
+            free->length = start - free->start;
+            if(free_end > end && volume->free_count < LAMAXFS_FREE_CACHE) {
+                volume->free_cache[volume->free_count].start = end;
+                volume->free_cache[volume->free_count].length = free_end - end;
+                volume->free_count++;
+            }
+        }
+    }
+
+    uint32_t kept = 0;
+    for(uint32_t i = 0; i < volume->free_count; i++) {
+        if(volume->free_cache[i].length) volume->free_cache[kept++] = volume->free_cache[i];
+    }
+    volume->free_count = kept;
+}
+
+// Bitişik en çok want blok ayır; goal boşsa oradan başlar (extent'i uzatmak
+// için). Dönüş: ayrılan blok sayısı, 0: yer yok
+static uint32_t lamaxfs_alloc(lamaxfs_volume_t* volume, uint32_t goal, uint32_t want, uint32_t* start) {
+    if(want == 0 || volume->super.free_blocks == 0) return 0;
+
+    if(goal >= volume->super.data_start && goal < volume->super.block_count) {
+        uint32_t length = 0;
+        while(length < want && goal + length < volume->super.block_count &&
+              lamaxfs_bitmap_test(volume, goal + length) == 0) {
+            length++;
+        }
+        if(length) {
+            *start = goal;
+            lamaxfs_take(volume, goal, length);
+            return length;
+        }
+    }
+
+    if(volume->free_count == 0) lamaxfs_refill(volume);
+    if(volume->free_count == 0) return 0;
+
+    // En uygun: want'a yeten en kısa aralık; yoksa en uzunu
+    uint32_t best = 0;
+    for(uint32_t i = 1; i < volume->free_count; i++) {
+        uint32_t length = volume->free_cache[i].length;
+        uint32_t best_length = volume->free_cache[best].length;
+        if(best_length >= want ? (length >= want && length < best_length) : length > best_length) best = i;
+    }
+
+    uint32_t length = volume->free_cache[best].length;
+    if(length > want) length = want;
+    *start = volume->free_cache[best].start;
+    lamaxfs_take(volume, *start, length);
+    return length;
+}
+
+static void lamaxfs_free(lamaxfs_volume_t* volume, uint32_t start, uint32_t length) {
+    if(length == 0) return;
+
+    lamaxfs_bitmap_set(volume, start, length, false);
+    volume->super.free_blocks += length;
+
+    for(uint32_t i = 0; i < volume->free_count; i++) {
+        lamaxfs_extent_t* free = &volume->free_cache[i];
+        if(free->start + free->length == start) {
+            free->length += length;
+            return;
+        }
+        if(start + length == free->start) {
+            free->start = start;
+            free->length += length;
+            return;
+        }
+    }
+    if(volume->free_count < LAMAXFS_FREE_CACHE) {
+        volume->free_cache[volume->free_count].start = start;
+        volume->free_cache[volume->free_count].length = length;
+        volume->free_count++;
+    }
+}
+
+// Bloğu okumadan al ve sıfırla
+static int lamaxfs_zero_block(lamaxfs_volume_t* volume, uint32_t block) {
+    buffer_t* buffer = bcache_get(volume->device, block);
+    if(!buffer) return -1;
+
+    if(buffer->flags & BUFFER_READING) block_wait(volume->device, &buffer->request);
+    memset(buffer->data, 0, LAMAXFS_BLOCK_SIZE);
+    bcache_dirty(buffer);
+    bcache_release(buffer);
+    return 0;
+}
+
+static int lamaxfs_get_extent(lamaxfs_volume_t* volume, const lamaxfs_inode_t* inode, uint32_t index,
+                              lamaxfs_extent_t* extent) {
+    if(index < LAMAXFS_INLINE_EXTENTS) {
+        *extent = inode->extents[index];
+        return 0;
+    }
+
+    buffer_t* buffer = bcache_read(volume->device, inode->extent_block);
+    if(!buffer) return -1;
+    *extent = ((lamaxfs_extent_t*)buffer->data)[index - LAMAXFS_INLINE_EXTENTS];
+    bcache_release(buffer);
+    return 0;
+}
+
+static int lamaxfs_set_extent(lamaxfs_volume_t* volume, lamaxfs_inode_t* inode, uint32_t index,
+                              const lamaxfs_extent_t* extent) {
+    if(index < LAMAXFS_INLINE_EXTENTS) {
+        inode->extents[index] = *extent;
+        return 0;
+    }
+
+    if(!inode->extent_block) {
+        uint32_t block;
+        if(lamaxfs_alloc(volume, 0, 1, &block) != 1) return -1;
+        if(lamaxfs_zero_block(volume, block) != 0) {
+            lamaxfs_free(volume, block, 1);
+            return -1;
+        }
+        inode->extent_block = block;
+    }
+
+    buffer_t* buffer = bcache_read(volume->device, inode->extent_block);
+    if(!buffer) return -1;
+    ((lamaxfs_extent_t*)buffer->data)[index - LAMAXFS_INLINE_EXTENTS] = *extent;
+    bcache_dirty(buffer);
+    bcache_release(buffer);
+    return 0;
+}
+
+// Mantıksal bloğu fiziksel bloğa çevir; run: extent'te bu bloktan
+// itibaren kalan bitişik blok sayısı
+static int lamaxfs_map(lamaxfs_volume_t* volume, const lamaxfs_inode_t* inode, uint32_t logical,
+                       uint32_t* physical, uint32_t* run) {
+    const lamaxfs_extent_t* extents = inode->extents;
+    buffer_t* buffer = NULL;
+    uint32_t base = 0;
+    int result = -1;
+
+    for(uint32_t i = 0; i < inode->extent_count; i++) {
+        // Ek bloğa geçince bir kez oku
+        if(i == LAMAXFS_INLINE_EXTENTS) {
+            buffer = bcache_read(volume->device, inode->extent_block);
+            if(!buffer) return -1;
+            extents = (const lamaxfs_extent_t*)buffer->data - LAMAXFS_INLINE_EXTENTS;
+        }
+
+        if(logical < base + extents[i].length) {
+            *physical = extents[i].start + (logical - base);
+            *run = extents[i].length - (logical - base);
+            result = 0;
+            break;
+        }
+        base += extents[i].length;
+    }
+
+    if(buffer) bcache_release(buffer);
+    return result;
+}
+
+// Inode'a toplam blocks bloğa ulaşana kadar yer ekle; her adım son
+// extent'in ardından başlar, bitişikse extent uzar
+static int lamaxfs_grow(lamaxfs_volume_t* volume, lamaxfs_inode_t* inode, uint32_t blocks) {
+    while(inode->blocks < blocks) {
+        lamaxfs_extent_t last = { 0, 0 };
+        if(inode->extent_count && lamaxfs_get_extent(volume, inode, inode->extent_count - 1, &last) != 0) {
+            return -1;
+        }
+
+        uint32_t goal = last.length ? last.start + last.length : 0;
+        uint32_t start;
+        uint32_t length = lamaxfs_alloc(volume, goal, blocks - inode->blocks, &start);
+        if(length == 0) return -1;
+
+        if(last.length && start == goal) {
+            last.length += length;
+            lamaxfs_set_extent(volume, inode, inode->extent_count - 1, &last);
+        } else {
+            lamaxfs_extent_t extent = { start, length };
+            if(inode->extent_count >= LAMAXFS_MAX_EXTENTS ||
+               lamaxfs_set_extent(volume, inode, inode->extent_count, &extent) != 0) {
+                lamaxfs_free(volume, start, length);
+                return -1;
+            }
+            inode->extent_count++;
+        }
+        inode->blocks += length;
+    }
+    return 0;
+}
+
+static void lamaxfs_release_blocks(lamaxfs_volume_t* volume, lamaxfs_inode_t* inode) {
+    for(uint32_t i = 0; i < inode->extent_count; i++) {
+        lamaxfs_extent_t extent;
+        if(lamaxfs_get_extent(volume, inode, i, &extent) == 0) lamaxfs_free(volume, extent.start, extent.length);
+    }
+    if(inode->extent_block) lamaxfs_free(volume, inode->extent_block, 1);
+
+    inode->extent_count = 0;
+    inode->extent_block = 0;
+    inode->blocks = 0;
+    inode->size = 0;
+}
+
+// Dosya içeriği ile bellek arasında kopyala; bloklar önbellekten
+static int lamaxfs_transfer(lamaxfs_volume_t* volume, lamaxfs_inode_t* inode, uint32_t offset,
+                            uint8_t* data, uint32_t size, bool write) {
+    uint64_t old_size = inode->size;
+
+    while(size) {
+        uint32_t logical = offset / LAMAXFS_BLOCK_SIZE;
+        uint32_t within = offset % LAMAXFS_BLOCK_SIZE;
+        uint32_t chunk = LAMAXFS_BLOCK_SIZE - within;
+        uint32_t physical, run;
+        if(chunk > size) chunk = size;
+        if(lamaxfs_map(volume, inode, logical, &physical, &run) != 0) return -1;
+
+        buffer_t* buffer;
+        uint64_t block_start = (uint64_t)logical * LAMAXFS_BLOCK_SIZE;
+        if(write && (chunk == LAMAXFS_BLOCK_SIZE || block_start >= old_size)) {
+            // Eski veri korunmayacak: okumadan al
+            buffer = bcache_get(volume->device, physical);
+            if(!buffer) return -1;
+            if(buffer->flags & BUFFER_READING) block_wait(volume->device, &buffer->request);
+            if(chunk != LAMAXFS_BLOCK_SIZE) memset(buffer->data, 0, LAMAXFS_BLOCK_SIZE);
+        } else {
+            buffer = bcache_read(volume->device, physical);
+            if(!buffer) return -1;
+        }
+
+        if(write) {
+            memcpy(buffer->data + within, data, chunk);
+            bcache_dirty(buffer);
+        } else {
+            memcpy(data, buffer->data + within, chunk);
+        }
+        bcache_release(buffer);
+
+        data += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+    return 0;
+}
+
+// Dizin işlemleri
+
+static buffer_t* lamaxfs_dir_block(lamaxfs_volume_t* volume, const lamaxfs_inode_t* dir, uint32_t logical) {
+    uint32_t physical, run;
+    if(lamaxfs_map(volume, dir, logical, &physical, &run) != 0) return NULL;
+    return bcache_read(volume->device, physical);
+}
+
+// Dizine sıfırlanmış yeni bir mantıksal blok ekle
+static int lamaxfs_dir_extend(lamaxfs_volume_t* volume, lamaxfs_inode_t* dir, lamaxfs_dir_header_t* header,
+                              uint32_t* logical) {
+    uint32_t physical, run;
+
+    // Araya dosya blokları girip dizin extent'lere bölünmesin diye önden ayır
+    *logical = header->next_block;
+    uint32_t blocks = (*logical + LAMAXFS_DIR_PREALLOC) & ~(LAMAXFS_DIR_PREALLOC - 1);
+    if(lamaxfs_grow(volume, dir, blocks) != 0 && lamaxfs_grow(volume, dir, *logical + 1) != 0) return -1;
+    if(lamaxfs_map(volume, dir, *logical, &physical, &run) != 0) return -1;
+    if(lamaxfs_zero_block(volume, physical) != 0) return -1;
+
+    header->next_block++;
+    dir->size = (uint64_t)header->next_block * LAMAXFS_BLOCK_SIZE;
+    return 0;
+}
+
+// Kovanın zincirinde boş yere yaz; zincir doluysa taşma bloğu ekle
+static int lamaxfs_bucket_add(lamaxfs_volume_t* volume, lamaxfs_inode_t* dir, lamaxfs_dir_header_t* header,
+                              uint32_t bucket, const lamaxfs_dirent_t* entry) {
+    uint32_t logical = header->buckets[bucket];
+
+    for(;;) {
+        buffer_t* buffer = lamaxfs_dir_block(volume, dir, logical);
+        if(!buffer) return -1;
+        lamaxfs_dir_block_t* block = (lamaxfs_dir_block_t*)buffer->data;
+
+        for(uint32_t i = 0; i < LAMAXFS_DIRENTS_PER_BLOCK; i++) {
+            if(block->entries[i].inode) continue;
+            block->entries[i] = *entry;
+            bcache_dirty(buffer);
+            bcache_release(buffer);
+            return 0;
+        }
+
+        if(block->next) {
+            logical = block->next;
+            bcache_release(buffer);
+            continue;
+        }
+
+        uint32_t overflow;
+        bcache_release(buffer);
+        if(lamaxfs_dir_extend(volume, dir, header, &overflow) != 0) return -1;
+
+        buffer = lamaxfs_dir_block(volume, dir, logical);
+        if(!buffer) return -1;
+        ((lamaxfs_dir_block_t*)buffer->data)->next = overflow;
+        bcache_dirty(buffer);
+        bcache_release(buffer);
+        logical = overflow;
+    }
+}
+
+// Doğrusal karma: split kovasını yeni kovayla paylaştır. Girdiler önce
+// kopyalanır, split ancak sonra ilerler; yarıda kalan bölme aramaları
+// bozmaz.
+static bool lamaxfs_split_moves(uint32_t size, uint32_t new_bucket, const lamaxfs_dirent_t* entry) {
+    return entry->inode && lamaxfs_hash(entry->name, entry->name_length) % (size << 1) == new_bucket;
+}
+
+static int lamaxfs_dir_split(lamaxfs_volume_t* volume, lamaxfs_inode_t* dir, lamaxfs_dir_header_t* header) {
+    uint32_t size = header->base << header->level;
+    uint32_t old_bucket = header->split;
+    uint32_t new_bucket = size + header->split;
+    uint32_t logical;
+
+    if(lamaxfs_dir_extend(volume, dir, header, &logical) != 0) return -1;
+    header->buckets[new_bucket] = logical;
+
+    for(int pass = 0; pass < 2; pass++) {
+        for(logical = header->buckets[old_bucket]; logical; ) {
+            buffer_t* buffer = lamaxfs_dir_block(volume, dir, logical);
+            if(!buffer) return -1;
+            lamaxfs_dir_block_t* block = (lamaxfs_dir_block_t*)buffer->data;
+
+            for(uint32_t i = 0; i < LAMAXFS_DIRENTS_PER_BLOCK; i++) {
+                lamaxfs_dirent_t* entry = &block->entries[i];
+                if(!lamaxfs_split_moves(size, new_bucket, entry)) continue;
+
+                if(pass == 1) {
+                    entry->inode = 0;
+                    bcache_dirty(buffer);
+                } else if(lamaxfs_bucket_add(volume, dir, header, new_bucket, entry) != 0) {
+                    bcache_release(buffer);
+                    return -1;
+                }
+            }
+
+            logical = block->next;
+            bcache_release(buffer);
+        }
+
+        if(pass == 0 && ++header->split == size) {
+            header->level++;
+            header->split = 0;
+        }
+    }
+    return 0;
+}
+
+// Adı kovasında ara; bulunursa girdinin bloğu ve yuvası da döner
+static int lamaxfs_dir_find(lamaxfs_volume_t* volume, const lamaxfs_inode_t* dir, const char* name,
+                            lamaxfs_dirent_t* found, uint32_t* found_block, uint32_t* found_slot) {
+    uint32_t length = strlen(name);
+    if(length == 0 || length > LAMAXFS_NAME_MAX) return -1;
+
+    buffer_t* buffer = lamaxfs_dir_block(volume, dir, 0);
+    if(!buffer) return -1;
+    lamaxfs_dir_header_t* header = (lamaxfs_dir_header_t*)buffer->data;
+    uint32_t logical = header->buckets[lamaxfs_bucket(header, lamaxfs_hash(name, length))];
+    bcache_release(buffer);
+
+    while(logical) {
+        buffer = lamaxfs_dir_block(volume, dir, logical);
+        if(!buffer) return -1;
+        lamaxfs_dir_block_t* block = (lamaxfs_dir_block_t*)buffer->data;
+
+        for(uint32_t i = 0; i < LAMAXFS_DIRENTS_PER_BLOCK; i++) {
+            lamaxfs_dirent_t* entry = &block->entries[i];
+            if(!entry->inode || entry->name_length != length || memcmp(entry->name, name, length) != 0) continue;
+
+            *found = *entry;
+            if(found_block) *found_block = logical;
+            if(found_slot) *found_slot = i;
+            bcache_release(buffer);
+            return 0;
+        }
+
+        logical = block->next;
+        bcache_release(buffer);
+    }
+    return -1;
+}
+
+static int lamaxfs_dir_insert(lamaxfs_volume_t* volume, lamaxfs_inode_t* dir, const char* name,
+                              uint32_t number, uint8_t type) {
+    lamaxfs_dirent_t entry;
+    uint32_t length = strlen(name);
+
+    memset(&entry, 0, sizeof(entry));
+    entry.inode = number;
+    entry.type = type;
+    entry.name_length = (uint8_t)length;
+    memcpy(entry.name, name, length);
+
+    // Başlık işlem boyunca sabit tutulur; kova tablosu yerinde güncellenir
+    buffer_t* buffer = lamaxfs_dir_block(volume, dir, 0);
+    if(!buffer) return -1;
+    lamaxfs_dir_header_t* header = (lamaxfs_dir_header_t*)buffer->data;
+
+    int result = lamaxfs_bucket_add(volume, dir, header, lamaxfs_bucket(header, lamaxfs_hash(name, length)), &entry);
+    if(result == 0) {
+        header->entries++;
+        if(header->entries > lamaxfs_bucket_count(header) * LAMAXFS_DIR_SPLIT_LOAD &&
+           lamaxfs_bucket_count(header) < LAMAXFS_DIR_MAX_BUCKETS) {
+            // Bölünemezse dizin yine tutarlıdır, yalnızca zincir uzar
+            lamaxfs_dir_split(volume, dir, header);
+        }
+    }
+    bcache_dirty(buffer);
+    bcache_release(buffer);
+    return result;
+}
+
+static int lamaxfs_dir_init(lamaxfs_volume_t* volume, lamaxfs_inode_t* dir) {
+    uint32_t physical, run;
+
+    if(lamaxfs_grow(volume, dir, 2) != 0) return -1;
+    if(lamaxfs_map(volume, dir, 1, &physical, &run) != 0 || lamaxfs_zero_block(volume, physical) != 0) return -1;
+    if(lamaxfs_map(volume, dir, 0, &physical, &run) != 0) return -1;
+
+    buffer_t* buffer = bcache_get(volume->device, physical);
+    if(!buffer) return -1;
+    if(buffer->flags & BUFFER_READING) block_wait(volume->device, &buffer->request);
+    memset(buffer->data, 0, LAMAXFS_BLOCK_SIZE);
+
+    lamaxfs_dir_header_t* header = (lamaxfs_dir_header_t*)buffer->data;
+    header->base = 1;
+    header->next_block = 2;
+    header->buckets[0] = 1;
+    bcache_dirty(buffer);
+    bcache_release(buffer);
+
+    dir->size = 2 * LAMAXFS_BLOCK_SIZE;
+    return 0;
+}
+
+static uint32_t lamaxfs_alloc_inode(lamaxfs_volume_t* volume) {
+    uint32_t count = volume->super.inode_count;
+
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t number = (volume->inode_hint + i) % count;
+        lamaxfs_inode_t inode;
+        if(number == 0 || lamaxfs_read_inode(volume, number, &inode) != 0) continue;
+
+        if(inode.type == LAMAXFS_TYPE_FREE) {
+            volume->inode_hint = number + 1;
+            return number;
+        }
+    }
+    return 0;
+}
+
+// VFS işlemleri
+
+static lamaxfs_open_t* lamaxfs_find_open(lamaxfs_volume_t* volume, uint32_t number) {
+    for(lamaxfs_open_t* open = volume->opens; open; open = open->next) {
+        if(open->inode == number) return open;
+    }
+    return NULL;
+}
+
+// Blokları ve inode'u bırak; girdisi önceden kaldırılmış olmalı
+static void lamaxfs_free_inode(lamaxfs_volume_t* volume, uint32_t number, lamaxfs_inode_t* inode) {
+    lamaxfs_release_blocks(volume, inode);
+    inode->type = LAMAXFS_TYPE_FREE;
+    inode->links = 0;
+    lamaxfs_write_inode(volume, number, inode);
+
+    volume->super.free_inodes++;
+    lamaxfs_write_super(volume);
+}
+
+static void lamaxfs_fill_node(vfs_mount_t* mount, uint32_t number, const lamaxfs_inode_t* inode, vfs_node_t* node) {
+    node->mount = mount;
+    node->id = number;
+    node->size = inode->size > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)inode->size;
+    node->attributes = 0;
+    node->is_directory = inode->type == LAMAXFS_TYPE_DIR;
+}
+
+static int lamaxfs_lookup(vfs_mount_t* mount, const vfs_node_t* dir, const char* name, vfs_node_t* node) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    lamaxfs_inode_t inode;
+    lamaxfs_dirent_t entry;
+
+    if(lamaxfs_read_inode(volume, (uint32_t)dir->id, &inode) != 0) return -1;
+    if(lamaxfs_dir_find(volume, &inode, name, &entry, NULL, NULL) != 0) return -1;
+    if(lamaxfs_read_inode(volume, entry.inode, &inode) != 0) return -1;
+
+    lamaxfs_fill_node(mount, entry.inode, &inode, node);
+    return 0;
+}
+
+// Konum, başlık sonrası bloklardaki düz girdi sırasıdır
+static int lamaxfs_readdir(vfs_mount_t* mount, file_t* dir, vfs_dirent_t* entry) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    lamaxfs_inode_t inode;
+
+    if(lamaxfs_read_inode(volume, (uint32_t)dir->node.id, &inode) != 0) return -1;
+    uint32_t blocks = (uint32_t)(inode.size / LAMAXFS_BLOCK_SIZE);
+
+    for(;;) {
+        uint32_t logical = 1 + dir->position / LAMAXFS_DIRENTS_PER_BLOCK;
+        uint32_t slot = dir->position % LAMAXFS_DIRENTS_PER_BLOCK;
+        if(logical >= blocks) return 0;
+
+        buffer_t* buffer = lamaxfs_dir_block(volume, &inode, logical);
+        if(!buffer) return -1;
+        lamaxfs_dir_block_t* block = (lamaxfs_dir_block_t*)buffer->data;
+
+        for(; slot < LAMAXFS_DIRENTS_PER_BLOCK; slot++) {
+            lamaxfs_dirent_t* raw = &block->entries[slot];
+            dir->position++;
+            if(!raw->inode) continue;
+
+            uint32_t number = raw->inode;
+            memcpy(entry->name, raw->name, raw->name_length);
+            entry->name[raw->name_length] = 0;
+            entry->is_directory = raw->type == LAMAXFS_TYPE_DIR;
+            entry->size = 0;
+            bcache_release(buffer);
+
+            lamaxfs_inode_t child;
+            if(!entry->is_directory && lamaxfs_read_inode(volume, number, &child) == 0) {
+                entry->size = (uint32_t)child.size;
+            }
+            return 1;
+        }
+        bcache_release(buffer);
+    }
+}
+
+// Dosyanın index. bloğunu aygıt bloğuna çevir; extent'te kalan uzunluk döner
+static uint32_t lamaxfs_readahead_map(void* context, uint64_t index, uint64_t* block) {
+    lamaxfs_map_context_t* map = context;
+    uint32_t physical, run;
+
+    if(lamaxfs_map(map->volume, map->inode, (uint32_t)index, &physical, &run) != 0) return 0;
+    *block = physical;
+    return run;
+}
+
+static int lamaxfs_read(vfs_mount_t* mount, file_t* file, void* buffer, uint32_t size) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    lamaxfs_inode_t inode;
+
+    if(lamaxfs_read_inode(volume, (uint32_t)file->node.id, &inode) != 0) return -1;
+
+    uint32_t first = file->position / LAMAXFS_BLOCK_SIZE;
+    uint32_t last = (file->position + size - 1) / LAMAXFS_BLOCK_SIZE;
+    uint64_t end = (inode.size + LAMAXFS_BLOCK_SIZE - 1) / LAMAXFS_BLOCK_SIZE;
+
+    lamaxfs_map_context_t context = { volume, &inode };
+    readahead_access(&file->readahead, volume->device, first, last - first + 1, end,
+                     lamaxfs_readahead_map, &context);
+
+    if(lamaxfs_transfer(volume, &inode, file->position, buffer, size, false) != 0) return -1;
+    return (int)size;
+}
+
+static int lamaxfs_write(vfs_mount_t* mount, file_t* file, const void* buffer, uint32_t size) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    lamaxfs_inode_t inode;
+    uint32_t number = (uint32_t)file->node.id;
+
+    if(lamaxfs_read_inode(volume, number, &inode) != 0) return -1;
+    if(file->position + size < file->position) size = 0xFFFFFFFF - file->position;
+
+    // Yer kalmadıysa ayrılabilen kadarı yazılır
+    uint32_t blocks = (uint32_t)(((uint64_t)file->position + size + LAMAXFS_BLOCK_SIZE - 1) / LAMAXFS_BLOCK_SIZE);
+    if(lamaxfs_grow(volume, &inode, blocks) != 0) {
+        uint64_t room = (uint64_t)inode.blocks * LAMAXFS_BLOCK_SIZE;
+        if(room <= file->position) size = 0;
+        else if(room - file->position < size) size = (uint32_t)(room - file->position);
+    }
+
+    int result = -1;
+    if(size && lamaxfs_transfer(volume, &inode, file->position, (uint8_t*)buffer, size, true) == 0) {
+        if((uint64_t)file->position + size > inode.size) inode.size = (uint64_t)file->position + size;
+        result = (int)size;
+    }
+
+    lamaxfs_write_inode(volume, number, &inode);
+    lamaxfs_write_super(volume);
+    return result;
+}
+
+static int lamaxfs_create(vfs_mount_t* mount, const vfs_node_t* dir, const char* name, bool is_directory,
+                          vfs_node_t* node) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    lamaxfs_inode_t parent;
+    lamaxfs_inode_t inode;
+    lamaxfs_dirent_t entry;
+    uint32_t parent_number = (uint32_t)dir->id;
+
+    if(strlen(name) == 0 || strlen(name) > LAMAXFS_NAME_MAX) return -1;
+    if(lamaxfs_read_inode(volume, parent_number, &parent) != 0 || parent.links == 0) return -1;
+    if(lamaxfs_dir_find(volume, &parent, name, &entry, NULL, NULL) == 0) return -1;
+
+    uint32_t number = lamaxfs_alloc_inode(volume);
+    if(number == 0) return -1;
+
+    memset(&inode, 0, sizeof(inode));
+    inode.type = is_directory ? LAMAXFS_TYPE_DIR : LAMAXFS_TYPE_FILE;
+    inode.links = 1;
+    if(is_directory && lamaxfs_dir_init(volume, &inode) != 0) {
+        lamaxfs_release_blocks(volume, &inode);
+        return -1;
+    }
+
+    // Inode girdiden önce yazılır: yarıda kalan oluşturma sahipsiz inode bırakır,
+    // boş inode'a işaret eden girdi bırakmaz
+    lamaxfs_write_inode(volume, number, &inode);
+    if(lamaxfs_dir_insert(volume, &parent, name, number, (uint8_t)inode.type) != 0) {
+        lamaxfs_release_blocks(volume, &inode);
+        inode.type = LAMAXFS_TYPE_FREE;
+        lamaxfs_write_inode(volume, number, &inode);
+        lamaxfs_write_inode(volume, parent_number, &parent);
+        return -1;
+    }
+    lamaxfs_write_inode(volume, parent_number, &parent);
+
+    volume->super.free_inodes--;
+    lamaxfs_write_super(volume);
+    lamaxfs_fill_node(mount, number, &inode, node);
+    return 0;
+}
+
+static int lamaxfs_unlink(vfs_mount_t* mount, const vfs_node_t* dir, const char* name) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    lamaxfs_inode_t parent;
+    lamaxfs_inode_t inode;
+    lamaxfs_dirent_t entry;
+    uint32_t logical, slot;
+
+    if(lamaxfs_read_inode(volume, (uint32_t)dir->id, &parent) != 0) return -1;
+    if(lamaxfs_dir_find(volume, &parent, name, &entry, &logical, &slot) != 0) return -1;
+    if(lamaxfs_read_inode(volume, entry.inode, &inode) != 0) return -1;
+
+    buffer_t* header_buffer = lamaxfs_dir_block(volume, &parent, 0);
+    if(!header_buffer) return -1;
+    lamaxfs_dir_header_t* header = (lamaxfs_dir_header_t*)header_buffer->data;
+
+    // Boş olmayan dizin silinmez
+    if(inode.type == LAMAXFS_TYPE_DIR) {
+        buffer_t* child = lamaxfs_dir_block(volume, &inode, 0);
+        bool empty = child && ((lamaxfs_dir_header_t*)child->data)->entries == 0;
+        if(child) bcache_release(child);
+        if(!empty) {
+            bcache_release(header_buffer);
+            return -1;
+        }
+    }
+
+    buffer_t* buffer = lamaxfs_dir_block(volume, &parent, logical);
+    if(!buffer) {
+        bcache_release(header_buffer);
+        return -1;
+    }
+    ((lamaxfs_dir_block_t*)buffer->data)->entries[slot].inode = 0;
+    bcache_dirty(buffer);
+    bcache_release(buffer);
+
+    header->entries--;
+    bcache_dirty(header_buffer);
+    bcache_release(header_buffer);
+
+    lamaxfs_open_t* open = lamaxfs_find_open(volume, entry.inode);
+    if(open) {
+        open->unlinked = true;
+        inode.links = 0;
+        lamaxfs_write_inode(volume, entry.inode, &inode);
+        return 0;
+    }
+    lamaxfs_free_inode(volume, entry.inode, &inode);
+    return 0;
+}
+
+static int lamaxfs_open(vfs_mount_t* mount, const vfs_node_t* node) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    uint32_t number = (uint32_t)node->id;
+
+    lamaxfs_open_t* open = lamaxfs_find_open(volume, number);
+    if(!open) {
+        open = kmalloc(sizeof(lamaxfs_open_t));
+        if(!open) return -1;
+        open->inode = number;
+        open->count = 0;
+        open->unlinked = false;
+        open->next = volume->opens;
+        volume->opens = open;
+    }
+    open->count++;
+    return 0;
+}
+
+static void lamaxfs_release(vfs_mount_t* mount, const vfs_node_t* node) {
+    lamaxfs_volume_t* volume = mount->fs_data;
+    uint32_t number = (uint32_t)node->id;
+
+    lamaxfs_open_t** link = &volume->opens;
+    while(*link && (*link)->inode != number) link = &(*link)->next;
+    lamaxfs_open_t* open = *link;
+    if(!open || --open->count) return;
+
+    *link = open->next;
+    lamaxfs_inode_t inode;
+    if(open->unlinked && lamaxfs_read_inode(volume, number, &inode) == 0) lamaxfs_free_inode(volume, number, &inode);
+    kfree(open);
+}
+
+static bool lamaxfs_mount(vfs_mount_t* mount) {
+    lamaxfs_volume_t* volume = NULL;
+    lamaxfs_inode_t root;
+
+    for(int i = 0; i < LAMAXFS_MAX_VOLUMES; i++) {
+        if(!lamaxfs_volumes[i].device) {
+            volume = &lamaxfs_volumes[i];
+            break;
+        }
+    }
+    if(!volume || mount->device->sectors < BCACHE_BLOCK_SECTORS) return false;
+
+    buffer_t* buffer = bcache_read(mount->device, 0);
+    if(!buffer) return false;
+    memcpy(&volume->super, buffer->data, sizeof(lamaxfs_super_t));
+    bcache_release(buffer);
+
+    lamaxfs_super_t* super = &volume->super;
+    if(super->magic != LAMAXFS_MAGIC || super->version != LAMAXFS_VERSION) return false;
+    if(super->block_size != LAMAXFS_BLOCK_SIZE) return false;
+    if(super->block_count > mount->device->sectors / BCACHE_BLOCK_SECTORS) return false;
+    if(super->data_start >= super->block_count || super->inode_count < 2) return false;
+
+    volume->device = mount->device;
+    volume->inode_hint = 1;
+    volume->scan_cursor = super->data_start;
+    volume->free_count = 0;
+    volume->opens = NULL;
+
+    if(lamaxfs_read_inode(volume, super->root_inode, &root) != 0 || root.type != LAMAXFS_TYPE_DIR) {
+        volume->device = NULL;
+        return false;
+    }
+
+    lamaxfs_fill_node(mount, super->root_inode, &root, &mount->root);
+    mount->fs_data = volume;
+    return true;
+}
+
+static vfs_ops_t lamaxfs_ops = {
+    .name = "lamaxfs",
+    .mount = lamaxfs_mount,
+    .lookup = lamaxfs_lookup,
+    .readdir = lamaxfs_readdir,
+    .read = lamaxfs_read,
+    .create = lamaxfs_create,
+    .write = lamaxfs_write,
+    .unlink = lamaxfs_unlink,
+    .open = lamaxfs_open,
+    .release = lamaxfs_release,
+};
+
+void lamaxfs_init() {
+    vfs_register_filesystem(&lamaxfs_ops);
+}
@@ -0,0 +1,125 @@
+/*
+ * LAMAX64 OS - LAMAXFS Disk Düzeni
+ * Version 1.0.0
+ *
+ * Çekirdek sürücüsü (lamaxfs.c) ile sunucu tarafı mkfs aracının
+ * (mkfs_lamaxfs.c) paylaştığı disk yapıları. Birim 4 KB'lık bloklardan
+ * oluşur:
+ *
+ *   0              süper blok
+ *   bitmap_start   blok bitmap'i (bit 1: kullanımda)
+ *   inode_start    inode tablosu (128 bayt, 0 numaralı inode kullanılmaz)
+ *   data_start     veri blokları
+ *
+ * Dosyalar extent (başlangıç, uzunluk) listesiyle saklanır; ilk 12
+ * extent inode içindedir, fazlası tek bir extent bloğunda. Dizinler
+ * doğrusal karma (linear hashing) tablosudur: mantıksal blok 0 başlık
+ * ve kova -> blok tablosu, her kova bir dizin bloğu ve taşma zinciridir.
+ * Bu dosya hem çekirdekte hem sunucuda derlenir: yalnızca sabit
+ * genişlikli tipler kullanır ve başka başlık içermez.
+ */
+
+#ifndef LAMAXFS_H
+#define LAMAXFS_H
+
+#define LAMAXFS_MAGIC               0x46584D4C      // 'LMXF'
+#define LAMAXFS_VERSION             1
+#define LAMAXFS_BLOCK_SIZE          4096
+#define LAMAXFS_BITS_PER_BLOCK      (LAMAXFS_BLOCK_SIZE * 8)
+
+#define LAMAXFS_INODE_SIZE          128
+#define LAMAXFS_INODES_PER_BLOCK    (LAMAXFS_BLOCK_SIZE / LAMAXFS_INODE_SIZE)
+#define LAMAXFS_ROOT_INODE          1
+
+#define LAMAXFS_TYPE_FREE           0
+#define LAMAXFS_TYPE_FILE           1
+#define LAMAXFS_TYPE_DIR            2
+
+#define LAMAXFS_INLINE_EXTENTS      12
+#define LAMAXFS_BLOCK_EXTENTS       (LAMAXFS_BLOCK_SIZE / 8)
+#define LAMAXFS_MAX_EXTENTS         (LAMAXFS_INLINE_EXTENTS + LAMAXFS_BLOCK_EXTENTS)
+
+#define LAMAXFS_NAME_MAX            58
+#define LAMAXFS_DIRENTS_PER_BLOCK   63
+#define LAMAXFS_DIR_MAX_BUCKETS     1008
+#define LAMAXFS_DIR_SPLIT_LOAD      48      // Kova başına ortalama girdi sınırı
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t block_size;
+    uint32_t block_count;
+    uint32_t bitmap_start;
+    uint32_t bitmap_blocks;
+    uint32_t inode_start;
+    uint32_t inode_blocks;
+    uint32_t inode_count;
+    uint32_t data_start;
+    uint32_t root_inode;
+    uint32_t free_blocks;
+    uint32_t free_inodes;
+} lamaxfs_super_t;
+
+typedef struct {
+    uint32_t start;
+    uint32_t length;
+} lamaxfs_extent_t;
+
+typedef struct {
+    uint16_t type;
+    uint16_t links;
+    uint32_t extent_count;
+    uint64_t size;
+    uint32_t mtime;
+    uint32_t extent_block;      // 12'den fazla extent varsa ek blok
+    uint32_t blocks;            // Extent'lerdeki toplam blok sayısı
+    uint32_t reserved;
+    lamaxfs_extent_t extents[LAMAXFS_INLINE_EXTENTS];
+} lamaxfs_inode_t;
+
+typedef struct {
+    uint32_t inode;             // 0: boş girdi
+    uint8_t type;
+    uint8_t name_length;
+    char name[LAMAXFS_NAME_MAX];
+} lamaxfs_dirent_t;
+
+// Dizin mantıksal blok 0. Kova sayısı: (base << level) + split
+typedef struct {
+    uint32_t entries;
+    uint32_t base;
+    uint32_t level;
+    uint32_t split;             // Sıradaki bölünecek kova
+    uint32_t next_block;        // Dizinin ilk kullanılmamış mantıksal bloğu
+    uint32_t reserved[11];
+    uint32_t buckets[LAMAXFS_DIR_MAX_BUCKETS];
+} lamaxfs_dir_header_t;
+
+typedef struct {
+    uint32_t next;              // Taşma bloğu (mantıksal), 0: yok
+    uint32_t reserved[15];
+    lamaxfs_dirent_t entries[LAMAXFS_DIRENTS_PER_BLOCK];
+} lamaxfs_dir_block_t;
+
+// FNV-1a
+static inline uint32_t lamaxfs_hash(const char* name, uint32_t length) {
+    uint32_t hash = 2166136261u;
+    for(uint32_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline uint32_t lamaxfs_bucket_count(const lamaxfs_dir_header_t* header) {
+    return (header->base << header->level) + header->split;
+}
+
+static inline uint32_t lamaxfs_bucket(const lamaxfs_dir_header_t* header, uint32_t hash) {
+    uint32_t size = header->base << header->level;
+    uint32_t bucket = hash % size;
+    if(bucket < header->split) bucket = hash % (size << 1);
+    return bucket;
+}
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * LAMAX64 OS - LAMAXFS Biçimlendirme Aracı (sunucu)
+ * Version 1.0.0
+ *
+ * Kullanım: mkfs.lamaxfs <imaj> <boyut-MB> [dosya...]
+ *
+ * Boş bir LAMAXFS birimi oluşturur ve verilen dosyaları kök dizine
+ * kopyalar. Her dosya tek bir bitişik extent olarak yazılır; kök dizinin
+ * kova sayısı dosya sayısına göre baştan seçilir, böylece çekirdek ilk
+ * eklemelerde kova bölmek zorunda kalmaz.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lamaxfs.h"
+
+typedef struct {
+    const char* path;
+    const char* name;
+    uint32_t size;
+    uint32_t start;
+    uint32_t blocks;
+    uint32_t bucket;
+} mkfs_file_t;
+
+static FILE* image;
+
+static void die(const char* message, const char* detail) {
+    fprintf(stderr, "mkfs.lamaxfs: %s%s%s\n", message, detail ? ": " : "", detail ? detail : "");
+    exit(1);
+}
+
+static void write_block(uint32_t block, const void* data) {
+    if(fseek(image, (long)block * LAMAXFS_BLOCK_SIZE, SEEK_SET) != 0 ||
+       fwrite(data, LAMAXFS_BLOCK_SIZE, 1, image) != 1) {
+        die("write failed", NULL);
+    }
+}
+
+static uint32_t blocks_for(uint64_t bytes) {
+    return (uint32_t)((bytes + LAMAXFS_BLOCK_SIZE - 1) / LAMAXFS_BLOCK_SIZE);
+}
+
+static void write_inode(const lamaxfs_super_t* super, uint32_t number, const lamaxfs_inode_t* inode) {
+    uint8_t block[LAMAXFS_BLOCK_SIZE];
+    uint32_t index = super->inode_start + number / LAMAXFS_INODES_PER_BLOCK;
+
+    if(fseek(image, (long)index * LAMAXFS_BLOCK_SIZE, SEEK_SET) != 0 ||
+       fread(block, LAMAXFS_BLOCK_SIZE, 1, image) != 1) {
+        die("read failed", NULL);
+    }
+    memcpy(block + (number % LAMAXFS_INODES_PER_BLOCK) * LAMAXFS_INODE_SIZE, inode, sizeof(*inode));
+    write_block(index, block);
+}
+
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        fprintf(stderr, "usage: mkfs.lamaxfs <image> <size-MB> [file...]\n");
+        return 1;
+    }
+
+    uint32_t megabytes = (uint32_t)strtoul(argv[2], NULL, 0);
+    if(megabytes == 0 || megabytes > 65536) die("invalid size", argv[2]);
+
+    uint32_t file_count = (uint32_t)(argc - 3);
+    mkfs_file_t* files = calloc(file_count ? file_count : 1, sizeof(mkfs_file_t));
+    if(!files) die("out of memory", NULL);
+
+    // Yerleşim
+    lamaxfs_super_t super;
+    memset(&super, 0, sizeof(super));
+    super.magic = LAMAXFS_MAGIC;
+    super.version = LAMAXFS_VERSION;
+    super.block_size = LAMAXFS_BLOCK_SIZE;
+    super.block_count = megabytes * (1024 * 1024 / LAMAXFS_BLOCK_SIZE);
+    super.bitmap_start = 1;
+    super.bitmap_blocks = (super.block_count + LAMAXFS_BITS_PER_BLOCK - 1) / LAMAXFS_BITS_PER_BLOCK;
+    super.inode_count = super.block_count / 4;
+    if(super.inode_count < file_count + 2) super.inode_count = file_count + 2;
+    super.inode_count = (super.inode_count + LAMAXFS_INODES_PER_BLOCK - 1) / LAMAXFS_INODES_PER_BLOCK *
+                        LAMAXFS_INODES_PER_BLOCK;
+    super.inode_start = super.bitmap_start + super.bitmap_blocks;
+    super.inode_blocks = super.inode_count / LAMAXFS_INODES_PER_BLOCK;
+    super.data_start = super.inode_start + super.inode_blocks;
+    super.root_inode = LAMAXFS_ROOT_INODE;
+
+    // Kök dizin: dosya sayısına yetecek kova, her kova bitişik bir zincir
+    lamaxfs_dir_header_t* header = calloc(1, sizeof(lamaxfs_dir_header_t));
+    if(!header) die("out of memory", NULL);
+    uint32_t buckets = (file_count + LAMAXFS_DIR_SPLIT_LOAD - 1) / LAMAXFS_DIR_SPLIT_LOAD;
+    if(buckets == 0) buckets = 1;
+    if(buckets > LAMAXFS_DIR_MAX_BUCKETS) buckets = LAMAXFS_DIR_MAX_BUCKETS;
+    header->entries = file_count;
+    header->base = buckets;
+
+    uint32_t* bucket_sizes = calloc(buckets, sizeof(uint32_t));
+    if(!bucket_sizes) die("out of memory", NULL);
+
+    for(uint32_t i = 0; i < file_count; i++) {
+        mkfs_file_t* file = &files[i];
+        file->path = argv[3 + i];
+        const char* slash = strrchr(file->path, '/');
+        file->name = slash ? slash + 1 : file->path;
+
+        size_t length = strlen(file->name);
+        if(length == 0 || length > LAMAXFS_NAME_MAX) die("bad file name", file->path);
+        for(uint32_t j = 0; j < i; j++) {
+            if(strcmp(files[j].name, file->name) == 0) die("duplicate name", file->name);
+        }
+
+        FILE* input = fopen(file->path, "rb");
+        if(!input) die("cannot open", file->path);
+        fseek(input, 0, SEEK_END);
+        long size = ftell(input);
+        fclose(input);
+        if(size < 0 || (uint64_t)size > 0xFFFFFFFFu) die("file too large", file->path);
+
+        file->size = (uint32_t)size;
+        file->blocks = blocks_for(file->size);
+        file->bucket = lamaxfs_bucket(header, lamaxfs_hash(file->name, (uint32_t)length));
+        bucket_sizes[file->bucket]++;
+    }
+
+    uint32_t dir_blocks = 1;
+    for(uint32_t b = 0; b < buckets; b++) {
+        uint32_t chain = (bucket_sizes[b] + LAMAXFS_DIRENTS_PER_BLOCK - 1) / LAMAXFS_DIRENTS_PER_BLOCK;
+        header->buckets[b] = dir_blocks;
+        dir_blocks += chain ? chain : 1;
+    }
+    header->next_block = dir_blocks;
+
+    uint32_t next = super.data_start + dir_blocks;
+    for(uint32_t i = 0; i < file_count; i++) {
+        files[i].start = next;
+        next += files[i].blocks;
+    }
+    if(next > super.block_count) die("image too small for the given files", NULL);
+
+    super.free_blocks = super.block_count - next;
+    super.free_inodes = super.inode_count - 2 - file_count;
+
+    image = fopen(argv[1], "w+b");
+    if(!image) die("cannot create", argv[1]);
+
+    uint8_t block[LAMAXFS_BLOCK_SIZE];
+    memset(block, 0, sizeof(block));
+    write_block(super.block_count - 1, block);
+    for(uint32_t i = 0; i < super.data_start; i++) write_block(i, block);
+
+    memcpy(block, &super, sizeof(super));
+    write_block(0, block);
+
+    // Bitmap: meta veri, kök dizin ve dosyalar [0, next) kullanımda
+    for(uint32_t i = 0; i < super.bitmap_blocks; i++) {
+        memset(block, 0, sizeof(block));
+        for(uint32_t bit = 0; bit < LAMAXFS_BITS_PER_BLOCK; bit++) {
+            uint32_t index = i * LAMAXFS_BITS_PER_BLOCK + bit;
+            if(index < next || index >= super.block_count) block[bit / 8] |= 1 << (bit % 8);
+        }
+        write_block(super.bitmap_start + i, block);
+    }
+
+    // Kök dizin blokları
+    write_block(super.data_start, header);
+    uint32_t* filled = calloc(buckets, sizeof(uint32_t));
+    if(!filled) die("out of memory", NULL);
+
+    for(uint32_t b = 0; b < buckets; b++) {
+        uint32_t chain = (bucket_sizes[b] + LAMAXFS_DIRENTS_PER_BLOCK - 1) / LAMAXFS_DIRENTS_PER_BLOCK;
+        if(chain == 0) chain = 1;
+
+        for(uint32_t c = 0; c < chain; c++) {
+            lamaxfs_dir_block_t dir;
+            memset(&dir, 0, sizeof(dir));
+            dir.next = c + 1 < chain ? header->buckets[b] + c + 1 : 0;
+
+            uint32_t slot = 0;
+            for(uint32_t i = 0; i < file_count && slot < LAMAXFS_DIRENTS_PER_BLOCK; i++) {
+                if(files[i].bucket != b) continue;
+                if(filled[b]++ < c * LAMAXFS_DIRENTS_PER_BLOCK) continue;
+
+                lamaxfs_dirent_t* entry = &dir.entries[slot++];
+                entry->inode = LAMAXFS_ROOT_INODE + 1 + i;
+                entry->type = LAMAXFS_TYPE_FILE;
+                entry->name_length = (uint8_t)strlen(files[i].name);
+                memcpy(entry->name, files[i].name, entry->name_length);
+            }
+            filled[b] = 0;
+            write_block(super.data_start + header->buckets[b] + c, &dir);
+        }
+    }
+
+    lamaxfs_inode_t inode;
+    memset(&inode, 0, sizeof(inode));
+    inode.type = LAMAXFS_TYPE_DIR;
+    inode.links = 1;
+    inode.size = (uint64_t)dir_blocks * LAMAXFS_BLOCK_SIZE;
+    inode.blocks = dir_blocks;
+    inode.extent_count = 1;
+    inode.extents[0].start = super.data_start;
+    inode.extents[0].length = dir_blocks;
+    write_inode(&super, LAMAXFS_ROOT_INODE, &inode);
+
+    // Dosyalar
+    for(uint32_t i = 0; i < file_count; i++) {
+        mkfs_file_t* file = &files[i];
+        FILE* input = fopen(file->path, "rb");
+        if(!input) die("cannot open", file->path);
+
+        for(uint32_t b = 0; b < file->blocks; b++) {
+            memset(block, 0, sizeof(block));
+            if(fread(block, 1, sizeof(block), input) == 0) die("read failed", file->path);
+            write_block(file->start + b, block);
+        }
+        fclose(input);
+
+        memset(&inode, 0, sizeof(inode));
+        inode.type = LAMAXFS_TYPE_FILE;
+        inode.links = 1;
+        inode.size = file->size;
+        inode.blocks = file->blocks;
+        if(file->blocks) {
+            inode.extent_count = 1;
+            inode.extents[0].start = file->start;
+            inode.extents[0].length = file->blocks;
+        }
+        write_inode(&super, LAMAXFS_ROOT_INODE + 1 + i, &inode);
+    }
+
+    if(fclose(image) != 0) die("write failed", argv[1]);
+    printf("%s: %u blocks, %u inodes, %u files, %u blocks free\n", argv[1], super.block_count,
+           super.inode_count, file_count, super.free_blocks);
+    return 0;
+}
@@ -0,0 +1,326 @@
+/*
+ * LAMAX64 OS - Fiziksel Sayfa Ayırıcı
+ * Version 1.0.0
+ *
+ * Açılış kesiminin 0x0600'e bıraktığı E820 haritasından kurulur; harita
+ * yoksa eski sabit pencereye (1-16 MB) düşer.
+ *
+ * İkili eş (buddy) ayırıcıdır: bellek 2^order sayfalık, kendi boyuna
+ * hizalı bloklardır ve her bölgenin her derece için ayrı bir boş listesi
+ * vardır. Ayırma en küçük uygun bloğu alıp fazlasını yarılayarak geri
+ * verir, bırakma bloğu boş eşiyle birleştirerek yukarı çıkar; ikisi de
+ * en fazla PMM_MAX_ORDER adımdır. Liste bağları boş bloğun ilk sayfasında
+ * durur (bellek birebir eşlenik); sayfa başına tek bayt, sayfanın boş bir
+ * blok başı olup olmadığını ve derecesini tutar. Bu dizi kernel imajının
+ * ardındaki ilk uygun boş alana yerleşir.
+ */
+
+#include "system.h"
+
+// Bu adresin üstü eşlenmiş değil (vmm_init doğrudan eşlemi)
+#define PMM_ADDRESS_LIMIT   vmm_mapped_limit()
+#define PMM_RESERVED_LOW    0x100000    // BIOS, VGA, açılış blokları, yükleyiciler
+#define PMM_DMA_PAGES       (PMM_DMA_LIMIT / PAGE_SIZE)
+
+// pmm_pages[] değerleri: 0..PMM_MAX_ORDER boş blok başı ve derecesi,
+// ayrılmış sayfada NONE ya da sahibinin etiketi (pmm_set_tag)
+#define PMM_PAGE_NONE       PMM_TAG_NONE
+#define PMM_PAGE_USABLE     0xFE        // Yalnızca kurulum sırasında
+
+// En büyük blok bölge sınırını (16 MB) aşamaz: eşler hep aynı bölgede
+#if (PAGE_SIZE << PMM_MAX_ORDER) > PMM_DMA_LIMIT
+#error "PMM_MAX_ORDER bölge sınırını aşıyor"
+#endif
+
+// Boş bloğun ilk baytları
+typedef struct pmm_page {
+    struct pmm_page* prev;
+    struct pmm_page* next;
+} pmm_page_t;
+
+extern char kernel_end[];   // linker.ld
+
+static const e820_map_t* pmm_map = (const e820_map_t*)E820_MAP_ADDR;
+static e820_map_t pmm_fallback_map;
+
+static uint8_t* pmm_pages = NULL;
+static uint32_t pmm_page_count = 0;
+static pmm_page_t* pmm_free_lists[PMM_ZONES][PMM_MAX_ORDER + 1];
+static pmm_stats_t pmm_stats;
+static spinlock_t pmm_lock;
+
+static inline int pmm_zone(uint32_t page) {
+    return page < PMM_DMA_PAGES ? PMM_ZONE_DMA : PMM_ZONE_NORMAL;
+}
+
+static inline pmm_page_t* pmm_page_address(uint32_t page) {
+    return (pmm_page_t*)((uintptr_t)page * PAGE_SIZE);
+}
+
+static void pmm_block_push(uint32_t page, uint32_t order) {
+    int zone = pmm_zone(page);
+    pmm_page_t* entry = pmm_page_address(page);
+
+    entry->prev = NULL;
+    entry->next = pmm_free_lists[zone][order];
+    if(entry->next) entry->next->prev = entry;
+    pmm_free_lists[zone][order] = entry;
+
+    pmm_pages[page] = order;
+    pmm_stats.free_blocks[zone][order]++;
+    pmm_stats.free_pages[zone] += 1u << order;
+}
+
+static void pmm_block_unlink(uint32_t page, uint32_t order) {
+    int zone = pmm_zone(page);
+    pmm_page_t* entry = pmm_page_address(page);
+
+    if(entry->prev) entry->prev->next = entry->next;
+    else pmm_free_lists[zone][order] = entry->next;
+    if(entry->next) entry->next->prev = entry->prev;
+
+    pmm_pages[page] = PMM_PAGE_NONE;
+    pmm_stats.free_blocks[zone][order]--;
+    pmm_stats.free_pages[zone] -= 1u << order;
+}
+
+// En küçük uygun bloğu al, fazla yarıları alt derecelere geri ver
+static uintptr_t pmm_buddy_alloc(uint32_t order, int zone) {
+    for(uint32_t current = order; current <= PMM_MAX_ORDER; current++) {
+        pmm_page_t* entry = pmm_free_lists[zone][current];
+        if(!entry) continue;
+
+        uint32_t page = (uint32_t)((uintptr_t)entry / PAGE_SIZE);
+        pmm_block_unlink(page, current);
+        while(current > order) {
+            current--;
+            pmm_block_push(page + (1u << current), current);
+        }
+        return (uintptr_t)entry;
+    }
+    return 0;
+}
+
+// Eşi aynı derecede boşsa birleştir ve bir üst dereceyle tekrarla
+static void pmm_buddy_free(uint32_t page, uint32_t order) {
+    while(order < PMM_MAX_ORDER) {
+        uint32_t buddy = page ^ (1u << order);
+        if(buddy >= pmm_page_count || pmm_pages[buddy] != order) break;
+
+        pmm_block_unlink(buddy, order);
+        page &= ~(1u << order);
+        order++;
+    }
+    pmm_block_push(page, order);
+}
+
+// [page, end) aralığını en büyük hizalı bloklar halinde bırak
+static void pmm_release_range(uint32_t page, uint32_t end) {
+    while(page < end) {
+        uint32_t order = 0;
+        while(order < PMM_MAX_ORDER && !(page & (1u << order)) && page + (2u << order) <= end) order++;
+        pmm_buddy_free(page, order);
+        page += 1u << order;
+    }
+}
+
+// [base, end) aralığındaki sayfalara değer yaz; USABLE yalnızca tamamen
+// içerde kalan sayfalara yazılır
+static void pmm_mark_range(uint64_t base, uint64_t end, uint8_t value) {
+    bool inner = value == PMM_PAGE_USABLE;
+    uint64_t first = inner ? (base + PAGE_SIZE - 1) / PAGE_SIZE : base / PAGE_SIZE;
+    uint64_t last = inner ? end / PAGE_SIZE : (end + PAGE_SIZE - 1) / PAGE_SIZE;
+    if(last > pmm_page_count) last = pmm_page_count;
+
+    for(uint64_t page = first; page < last; page++) pmm_pages[page] = value;
+}
+
+static uint64_t pmm_entry_end(const e820_entry_t* entry) {
+    uint64_t end = entry->base + entry->length;
+    if(end < entry->base || end > PMM_ADDRESS_LIMIT) end = PMM_ADDRESS_LIMIT;
+    return end;
+}
+
+// Sayfa dizisi için yer: rezerve alanın üstünde, kullanılabilir bir aralıkta
+static uintptr_t pmm_place_array(uint64_t floor, uint32_t size) {
+    for(int i = 0; i < pmm_map->count; i++) {
+        const e820_entry_t* entry = &pmm_map->entries[i];
+        if(entry->type != E820_USABLE) continue;
+
+        uint64_t start = entry->base > floor ? entry->base : floor;
+        start = (start + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+        if(start + size <= pmm_entry_end(entry)) return (uintptr_t)start;
+    }
+    return 0;
+}
+
+void pmm_init() {
+    // E820 desteklemeyen BIOS: geleneksel alt bellek ve 1-16 MB
+    if(pmm_map->count == 0 || pmm_map->count > E820_MAX_ENTRIES) {
+        pmm_fallback_map.count = 2;
+        pmm_fallback_map.entries[0] = (e820_entry_t){0, 0xA0000, E820_USABLE, 1};
+        pmm_fallback_map.entries[1] = (e820_entry_t){0x100000, 0xF00000, E820_USABLE, 1};
+        pmm_map = &pmm_fallback_map;
+    }
+
+    uint64_t limit = 0;
+    pmm_stats = (pmm_stats_t){0};
+    for(int i = 0; i < pmm_map->count; i++) {
+        const e820_entry_t* entry = &pmm_map->entries[i];
+        if(entry->type != E820_USABLE) continue;
+
+        pmm_stats.installed += entry->length;
+        uint64_t end = pmm_entry_end(entry);
+        if(end > limit) limit = end;
+    }
+    pmm_page_count = (uint32_t)(limit / PAGE_SIZE);
+
+    uint64_t floor = (uintptr_t)kernel_end;
+    if(floor < PMM_RESERVED_LOW) floor = PMM_RESERVED_LOW;
+    floor = (floor + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+
+    pmm_pages = (uint8_t*)pmm_place_array(floor, pmm_page_count);
+    if(!pmm_pages) {
+        pmm_page_count = 0;
+        return;
+    }
+    memset(pmm_pages, PMM_PAGE_NONE, pmm_page_count);
+
+    // Önce kullanılabilir aralıklar açılır, sonra diğer türler geri
+    // kapatılır: çakışan girdilerde rezerve olan kazanır
+    for(int pass = 0; pass < 2; pass++) {
+        for(int i = 0; i < pmm_map->count; i++) {
+            const e820_entry_t* entry = &pmm_map->entries[i];
+            if((entry->type == E820_USABLE) != (pass == 0) || entry->base >= PMM_ADDRESS_LIMIT) continue;
+            pmm_mark_range(entry->base, pmm_entry_end(entry), pass == 0 ? PMM_PAGE_USABLE : PMM_PAGE_NONE);
+        }
+    }
+    pmm_mark_range(0, floor, PMM_PAGE_NONE);
+    pmm_mark_range((uintptr_t)pmm_pages, (uintptr_t)pmm_pages + pmm_page_count, PMM_PAGE_NONE);
+
+    // Kullanılabilir koşuları bloklara böl
+    for(int zone = 0; zone < PMM_ZONES; zone++) {
+        for(int order = 0; order <= PMM_MAX_ORDER; order++) pmm_free_lists[zone][order] = NULL;
+    }
+    uint32_t page = 0;
+    while(page < pmm_page_count) {
+        if(pmm_pages[page] != PMM_PAGE_USABLE) {
+            page++;
+            continue;
+        }
+
+        uint32_t end = page;
+        while(end < pmm_page_count && pmm_pages[end] == PMM_PAGE_USABLE) {
+            pmm_pages[end] = PMM_PAGE_NONE;
+            pmm_stats.total_pages[pmm_zone(end)]++;
+            end++;
+        }
+        pmm_release_range(page, end);
+        page = end;
+    }
+}
+
+// İstenen bölgede yer yoksa NORMAL, DMA bölgesine düşer; DMA yalnızca DMA'dan
+static uintptr_t pmm_alloc_zone(uint32_t order, int zone) {
+    uintptr_t address = 0;
+    if(zone == PMM_ZONE_NORMAL) address = pmm_buddy_alloc(order, PMM_ZONE_NORMAL);
+    if(!address) address = pmm_buddy_alloc(order, PMM_ZONE_DMA);
+    return address;
+}
+
+uintptr_t pmm_alloc_pages(uint32_t order, int zone) {
+    if(order > PMM_MAX_ORDER) return 0;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&pmm_lock);
+    uintptr_t address = pmm_alloc_zone(order, zone);
+    spin_unlock(&pmm_lock);
+    if(enabled) enable_interrupts();
+    return address;
+}
+
+void pmm_free_pages(uintptr_t address, uint32_t order) {
+    uint32_t page = (uint32_t)(address / PAGE_SIZE);
+    if(address % PAGE_SIZE || order > PMM_MAX_ORDER || page & ((1u << order) - 1)) return;
+    if(page >= pmm_page_count || pmm_page_count - page < (1u << order)) return;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&pmm_lock);
+
+    // Hâlâ boş blok başı olan sayfa: çift bırakma, yok sayılır
+    if(pmm_pages[page] > PMM_MAX_ORDER) pmm_buddy_free(page, order);
+
+    spin_unlock(&pmm_lock);
+    if(enabled) enable_interrupts();
+}
+
+uintptr_t pmm_alloc_page(int zone) {
+    return pmm_alloc_pages(0, zone);
+}
+
+void pmm_free_page(uintptr_t address) {
+    pmm_free_pages(address, 0);
+}
+
+// align: bayt, ikinin kuvveti (0: sayfa). Blok kendi boyuna hizalı
+// olduğundan hizalama dereceyi büyütür; fazla kuyruk hemen geri verilir.
+uintptr_t pmm_alloc_contiguous(uint32_t count, uint32_t align, int zone) {
+    uint32_t align_pages = align > PAGE_SIZE ? align / PAGE_SIZE : 1;
+    if(count == 0 || (align_pages & (align_pages - 1))) return 0;
+
+    uint32_t order = 0;
+    while(order <= PMM_MAX_ORDER && ((1u << order) < count || (1u << order) < align_pages)) order++;
+    if(order > PMM_MAX_ORDER) return 0;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&pmm_lock);
+
+    uintptr_t address = pmm_alloc_zone(order, zone);
+    if(address) {
+        uint32_t page = (uint32_t)(address / PAGE_SIZE);
+        pmm_release_range(page + count, page + (1u << order));
+    }
+
+    spin_unlock(&pmm_lock);
+    if(enabled) enable_interrupts();
+    return address;
+}
+
+void pmm_free_contiguous(uintptr_t base, uint32_t count) {
+    uint32_t page = (uint32_t)(base / PAGE_SIZE);
+    if(base % PAGE_SIZE || count == 0 || page >= pmm_page_count || pmm_page_count - page < count) return;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&pmm_lock);
+    pmm_release_range(page, page + count);
+    spin_unlock(&pmm_lock);
+    if(enabled) enable_interrupts();
+}
+
+// Ayrılmış sayfalara sahip bilgisi; slab ayırıcı kfree'de işaretçinin
+// slab'ını ve büyük blokların derecesini buradan bulur
+void pmm_set_tag(uintptr_t address, uint32_t count, uint8_t tag) {
+    uint32_t page = (uint32_t)(address / PAGE_SIZE);
+    if(tag <= PMM_MAX_ORDER || tag == PMM_PAGE_USABLE) return;
+    if(page >= pmm_page_count || pmm_page_count - page < count) return;
+
+    for(uint32_t i = 0; i < count; i++) pmm_pages[page + i] = tag;
+}
+
+uint8_t pmm_get_tag(uintptr_t address) {
+    uint32_t page = (uint32_t)(address / PAGE_SIZE);
+    if(page >= pmm_page_count || pmm_pages[page] <= PMM_MAX_ORDER) return PMM_TAG_NONE;
+    return pmm_pages[page];
+}
+
+const e820_map_t* pmm_memory_map() {
+    return pmm_map;
+}
+
+void pmm_get_stats(pmm_stats_t* stats) {
+    *stats = pmm_stats;
+}
@@ -0,0 +1,81 @@
+/*
+ * LAMAX64 OS - Sıralı Okuma Önsezisi (Readahead)
+ * Version 1.0.0
+ *
+ * Dosya okuyucusu her okumadan önce readahead_access'i çağırır. Ardışık
+ * erişim algılanınca istenen aralıkla birlikte bir pencere tampon
+ * önbelleğine asenkron okunur; okuyucu son pencereye girdiğinde iki
+ * katı büyüklükte bir sonraki pencere başlatılır. Böylece okuyucu
+ * mevcut parçayı tüketirken sürücüde her zaman bir pencere yolda olur.
+ * Rastgele erişim pencereyi sıfırlar.
+ */
+
+#include "system.h"
+
+void readahead_init(readahead_t* ra) {
+    ra->next = 0;
+    ra->start = 0;
+    ra->size = 0;
+}
+
+// Aygıt bloğu mantıksal blokla aynı olan düz akışlar (ham aygıt, bitişik dosya)
+uint32_t readahead_map_linear(void* context, uint64_t index, uint64_t* block) {
+    (void)context;
+    *block = index;
+    return 0xFFFFFFFF;
+}
+
+// [start, start + size) mantıksal aralığını bitişik parçalar halinde iste
+static void readahead_issue(block_device_t* device, uint64_t start, uint32_t size, uint64_t end,
+                            readahead_map_t map, void* context) {
+    if(start >= end) return;
+    if(start + size > end) size = (uint32_t)(end - start);
+
+    while(size) {
+        uint64_t block;
+        uint32_t run = map(context, start, &block);
+        if(run == 0) break;
+        if(run > size) run = size;
+
+        bcache_prefetch(device, block, run);
+        start += run;
+        size -= run;
+    }
+}
+
+// index: okunacak ilk mantıksal blok, count: blok sayısı, end: dosya sonu (blok)
+void readahead_access(readahead_t* ra, block_device_t* device, uint64_t index, uint32_t count,
+                      uint64_t end, readahead_map_t map, void* context) {
+    bool sequential = index == ra->next || (index == 0 && ra->size == 0);
+
+    ra->next = index + count;
+    if(!sequential) {
+        ra->size = 0;
+        return;
+    }
+
+    // İlk ardışık erişim: istenen aralık ve başlangıç penceresi tek seferde
+    if(ra->size == 0) {
+        uint32_t size = count + READAHEAD_MIN_BLOCKS;
+        if(size > READAHEAD_MAX_BLOCKS) size = READAHEAD_MAX_BLOCKS;
+        if(size < count) size = count;
+
+        ra->start = index;
+        ra->size = size;
+        readahead_issue(device, index, size, end, map, context);
+        return;
+    }
+
+    // Okuyucu son pencereye girdi: bir sonrakini şimdiden başlat
+    if(index + count > ra->start) {
+        uint64_t start = ra->start + ra->size;
+        if(start < index) start = index;
+
+        uint32_t size = ra->size * 2;
+        if(size > READAHEAD_MAX_BLOCKS) size = READAHEAD_MAX_BLOCKS;
+
+        ra->start = start;
+        ra->size = size;
+        readahead_issue(device, start, size, end, map, context);
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * LAMAX64 OS - Seri Port Sürücüsü (16550 UART)
+ * Version 1.0.0
+ *
+ * Yazılar önce yazılım halka tamponuna alınır. Verici boşaldığında
+ * (LSR.THRE) 16 baytlık FIFO tek seferde doldurulur, böylece her
+ * karakter için durum yazmacı beklenmez. Konsol flush'ı yalnızca FIFO'yu
+ * doldurur; kalanı THRE kesmesi (IRQ4) ya da bir sonraki yazma gönderir.
+ * Tamponu bekleyerek boşaltan serial_flush panik ve kapanış içindir.
+ */
+
+#include "system.h"
+
+// UART yazmaçları (taban porta göre)
+#define UART_DATA           0
+#define UART_IER            1
+#define UART_IIR            2
+#define UART_FCR            2
+#define UART_LCR            3
+#define UART_MCR            4
+#define UART_LSR            5
+#define UART_DLL            0
+#define UART_DLM            1
+
+#define UART_LSR_THRE       0x20
+#define UART_IER_THRE       0x02
+#define UART_FIFO_SIZE      16
+#define COM1_IRQ            4
+
+// Yazılım gönderim tamponu (2'nin kuvveti)
+#define SERIAL_TX_SIZE      4096
+#define SERIAL_TX_MASK      (SERIAL_TX_SIZE - 1)
+
+static uint16_t serial_port = 0;
+static char serial_tx[SERIAL_TX_SIZE];
+static volatile uint32_t serial_tx_head = 0;
+static volatile uint32_t serial_tx_tail = 0;
+static bool serial_irq_ready = false;
+
+// Verici boşsa FIFO'yu bir seferde doldur. Kuyruk ucunu IRQ4 de
+// ilerlettiği için yerel kesmeler kapalı çalışır.
+static void serial_kick() {
+    uintptr_t flags = irq_save();
+    if(inb(serial_port + UART_LSR) & UART_LSR_THRE) {
+        for(int i = 0; i < UART_FIFO_SIZE && serial_tx_tail != serial_tx_head; i++) {
+            outb(serial_port + UART_DATA, serial_tx[serial_tx_tail & SERIAL_TX_MASK]);
+            serial_tx_tail++;
+        }
+    }
+    irq_restore(flags);
+}
+
+// Tamponda veri kaldıkça THRE kesmesi açık kalır
+static void serial_update_irq() {
+    if(!serial_irq_ready) return;
+    outb(serial_port + UART_IER, serial_tx_tail != serial_tx_head ? UART_IER_THRE : 0x00);
+}
+
+// Beklemez: FIFO'yu doldur, kalan için THRE kesmesini aç
+static void serial_push() {
+    uintptr_t flags = irq_save();
+    serial_kick();
+    serial_update_irq();
+    irq_restore(flags);
+}
+
+// IRQ4: FIFO boşaldı, sıradaki parçayı gönder
+static void serial_irq() {
+    inb(serial_port + UART_IIR);
+    serial_kick();
+    serial_update_irq();
+}
+
+static void serial_enqueue(char c) {
+    // Tampon doluysa önce bir FIFO dolusu boşalt
+    while(serial_tx_head - serial_tx_tail >= SERIAL_TX_SIZE) {
+        serial_kick();
+    }
+    serial_tx[serial_tx_head & SERIAL_TX_MASK] = c;
+    serial_tx_head++;
+}
+
+// UART'ı 115200 8N1 olarak başlat; port yoksa false döner
+bool serial_init(uint16_t port) {
+    outb(port + UART_IER, 0x00);        // Kesmeler kapalı
+    outb(port + UART_LCR, 0x80);        // DLAB aç
+    outb(port + UART_DLL, 0x01);        // Bölen 1 = 115200 baud
+    outb(port + UART_DLM, 0x00);
+    outb(port + UART_LCR, 0x03);        // 8 bit, parite yok, 1 stop
+    outb(port + UART_FCR, 0xC7);        // FIFO aç, temizle, 14 bayt eşik
+
+    // Loopback ile portun varlığını kontrol et
+    outb(port + UART_MCR, 0x1E);
+    outb(port + UART_DATA, 0xAE);
+    if(inb(port + UART_DATA) != 0xAE) return false;
+
+    outb(port + UART_MCR, 0x0F);        // Normal mod, DTR/RTS/OUT1/OUT2
+    serial_port = port;
+    serial_tx_head = serial_tx_tail = 0;
+    return true;
+}
+
+void serial_write(const char* buffer, int length) {
+    if(!serial_port) return;
+
+    for(int i = 0; i < length; i++) {
+        if(buffer[i] == '\n') serial_enqueue('\r');
+        serial_enqueue(buffer[i]);
+    }
+    serial_push();
+}
+
+// Tamponun tamamını bekleyerek gönder (panik, kapanış, açılış ölçümü)
+void serial_flush() {
+    if(!serial_port) return;
+
+    while(serial_tx_tail != serial_tx_head) {
+        serial_kick();
+    }
+}
+
+// Kesmeler kurulduktan sonra THRE ile arka planda boşalt
+void serial_irq_init() {
+    if(!serial_port) return;
+
+    register_interrupt_handler(IRQ_BASE + COM1_IRQ, serial_irq);
+    serial_irq_ready = true;
+}
+
+// Konsol hedefi olarak seri port
+static void serial_sink_write(const char* buffer, int length, uint8_t color) {
+    (void)color;
+    serial_write(buffer, length);
+}
+
+static void serial_sink_flush() {
+    if(serial_port) serial_push();
+}
+
+static console_sink_t serial_sink = {
+    "serial", CONSOLE_SINK_SERIAL, true, serial_sink_write, serial_sink_flush, NULL
+};
+
+// COM1'i başlat ve konsola ekle
+bool serial_console_init() {
+    if(!serial_init(COM1_PORT)) return false;
+    console_register_sink(&serial_sink);
+    return true;
+}
@@ -4,10 +4,23 @@
  */
 
 #include "system.h"
+#include "ata.h"
 
-// VGA ekran tamponu
-volatile char* vga_buffer = (volatile char*)0xB8000;
-int cursor_x = 0, cursor_y = 0;
+// PS/2 denetleyicisi (shell'de IDT yok, yoklanır)
+#define KBD_DATA_PORT           0x60
+#define KBD_STATUS_PORT         0x64
+#define KBD_OUTPUT_FULL         0x01
+#define KBD_AUX_DATA            0x20    // Fare baytı
+#define KBD_RELEASE             0x80
+
+// Scancode set 1 -> ASCII; shell komutları küçük harf, shift yok
+static const char shell_keymap[] = {
+    0, 27, '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '-', '=', '\b',
+    '\t', 'q', 'w', 'e', 'r', 't', 'y', 'u', 'i', 'o', 'p', '[', ']', '\n',
+    0, 'a', 's', 'd', 'f', 'g', 'h', 'j', 'k', 'l', ';', '\'', '`',
+    0, '\\', 'z', 'x', 'c', 'v', 'b', 'n', 'm', ',', '.', '/', 0,
+    '*', 0, ' '
+};
 
 // String karşılaştırma
 int strcmp(const char* str1, const char* str2) {
@@ -33,92 +46,28 @@ void strcpy(char* dest, const char* src) {
     *dest = 0;
 }
 
-// Basit printf
-void kprint(const char* str) {
-    while(*str) {
-        if(*str == '\n') {
-            cursor_x = 0;
-            cursor_y++;
-        } else {
-            int index = (cursor_y * 80 + cursor_x) * 2;
-            vga_buffer[index] = *str;
-            vga_buffer[index + 1] = 0x0F; // Parlak beyaz
-            cursor_x++;
-        }
-        str++;
-        
-        if(cursor_x >= 80) {
-            cursor_x = 0;
-            cursor_y++;
-        }
-        
-        if(cursor_y >= 25) {
-            cursor_y = 24;
-            // Ekranı kaydır
-            for(int i = 0; i < 24 * 80; i++) {
-                vga_buffer[i * 2] = vga_buffer[(i + 80) * 2];
-                vga_buffer[i * 2 + 1] = vga_buffer[(i + 80) * 2 + 1];
-            }
-            for(int i = 24 * 80; i < 25 * 80; i++) {
-                vga_buffer[i * 2] = ' ';
-                vga_buffer[i * 2 + 1] = 0x0F;
-            }
-        }
-    }
-}
-
-// Renkli print
-void kprint_colored(const char* str, char color) {
-    char old_color = 0x0F;
-    while(*str) {
-        if(*str == '\n') {
-            cursor_x = 0;
-            cursor_y++;
-        } else {
-            int index = (cursor_y * 80 + cursor_x) * 2;
-            vga_buffer[index] = *str;
-            vga_buffer[index + 1] = color;
-            cursor_x++;
-        }
-        str++;
-        
-        if(cursor_x >= 80) {
-            cursor_x = 0;
-            cursor_y++;
-        }
-        
-        if(cursor_y >= 25) {
-            cursor_y = 24;
-            for(int i = 0; i < 24 * 80; i++) {
-                vga_buffer[i * 2] = vga_buffer[(i + 80) * 2];
-                vga_buffer[i * 2 + 1] = vga_buffer[(i + 80) * 2 + 1];
-            }
-            for(int i = 24 * 80; i < 25 * 80; i++) {
-                vga_buffer[i * 2] = ' ';
-                vga_buffer[i * 2 + 1] = 0x0F;
-            }
-        }
-    }
-}
-
 // Kernel yükle
 void load_kernel() {
     kprint_colored("\nLAMAX64 Shell - Loading Kernel...\n", 0x0E);
     kprint("Loading /kernel/lamax64-1.0.0\n");
     
-    // Yükleme animasyonu
-    for(int i = 0; i < 20; i++) {
-        kprint(".");
-        // Basit gecikme
-        for(volatile int j = 0; j < 1000000; j++) {}
+    // Kernel imajını tek çok sektörlü okuma ile KERNEL_START'a yükle
+    ata_device_t disk;
+    const boot_layout_t* layout = (const boot_layout_t*)BOOT_LAYOUT_ADDR;
+    uint64_t start = rdtsc();
+    if(!ata_init(&disk, ATA_PRIMARY_IO, ATA_PRIMARY_CTRL, false) ||
+       ata_read(&disk, layout->kernel_lba, layout->kernel_sectors, (void*)KERNEL_START) != 0) {
+        kprint_colored("ERROR: Failed to load kernel!\n", 0x0C);
+        while(1) HLT();
     }
+    boot_profile_add(BOOT_PROFILE_DISK, rdtsc() - start);
     
-    kprint("\n");
     kprint_colored("Kernel loaded successfully!\n", 0x0A);
     kprint("Transferring control to kernel...\n\n");
+    boot_profile_mark(BOOT_MARK_KERNEL_LOADED);
     
     // Kernel'e geç
-    void (*kernel_entry)() = (void(*)())0x100000;
+    void (*kernel_entry)() = (void(*)())KERNEL_START;
     kernel_entry();
 }
 
@@ -146,17 +95,57 @@ void execute_command(const char* cmd) {
     }
 }
 
-// Basit klavye girişi simülasyonu
+// Klavye denetleyicisinin çıkış tamponunu bekle, tarama kodunu oku
+static uint8_t shell_read_scancode() {
+    for(;;) {
+        uint8_t status = inb(KBD_STATUS_PORT);
+        if(!(status & KBD_OUTPUT_FULL)) {
+            __asm__ volatile("pause");
+            continue;
+        }
+        uint8_t scancode = inb(KBD_DATA_PORT);
+        if(!(status & KBD_AUX_DATA)) return scancode;
+    }
+}
+
+// Enter'a kadar bir satır oku (yankılı, geri silme destekli). Shell
+// kesmeleri kurmadığı için kernelin IRQ1 sürücüsü yerine yoklar.
 void get_input(char* buffer, int max_len) {
-    // Gerçek implementasyonda keyboard interrupt handler kullanılır
-    // Şimdilik otomatik olarak "load" komutunu çalıştır
-    strcpy(buffer, "load");
+    int length = 0;
+
+    for(;;) {
+        uint8_t scancode = shell_read_scancode();
+        // Bırakma ve 0xE0 önekli kodlar (ok tuşları vb.) yok sayılır
+        if(scancode & KBD_RELEASE || scancode >= sizeof(shell_keymap)) continue;
+
+        char c = shell_keymap[scancode];
+        if(c == '\n') break;
+        if(c == '\b') {
+            if(length > 0) {
+                length--;
+                console_backspace();
+            }
+            continue;
+        }
+        if(c >= ' ' && length < max_len) {
+            buffer[length++] = c;
+            console_putc(c, 0x0F);
+            console_flush();
+        }
+    }
+    buffer[length] = 0;
 }
 
-// Ana shell döngüsü
+// Ana shell döngüsü (shell.ld bunu imajın başına koyar)
+__attribute__((section(".text.entry")))
 void shell_main() {
     char input[128];
     
+    boot_profile_mark(BOOT_MARK_SHELL_MAIN);
+    
+    // Konsolu başlat (parlak beyaz)
+    console_init(0x0F);
+    
     // Shell başlangıç mesajı
     kprint_colored("========================================\n", 0x0B);
     kprint_colored("    LAMAX64 Operating System v1.0.0    \n", 0x0F);
@@ -169,16 +158,12 @@ void shell_main() {
     kprint_colored("lamax-shell> ", 0x0A);
     kprint("load\n");
     
-    // 2 saniye bekle
-    for(volatile int i = 0; i < 5000000; i++) {}
-    
     execute_command("load");
     
-    // Shell döngüsü (gerçek implementasyonda sonsuz döngü olur)
+    // Kernelden dönülürse komut satırı
     while(1) {
         kprint_colored("lamax-shell> ", 0x0A);
-        get_input(input, 127);
-        kprint(input);
+        get_input(input, sizeof(input) - 1);
         kprint("\n");
         execute_command(input);
     }
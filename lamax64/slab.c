@@ -0,0 +1,542 @@
+/*
+ * LAMAX64 OS - Slab Ayırıcı
+ * Version 1.0.0
+ *
+ * Nesne önbellekleri: her önbellek tek boyda nesneleri sayfa ayırıcıdan
+ * alınan 2^order sayfalık slab'lara dizer. Slab başlığı slabın ilk
+ * baytlarındadır; nesneler ardından önbellek satırına (küçük nesnelerde
+ * kendi boylarına) hizalı gelir.
+ *
+ * Slab katmanının önünde işlemci başına iki dergi (magazine) durur: boş
+ * nesnelerden oluşan küçük yığınlar. Ayırma ve bırakma önce bu işlemcinin
+ * yüklü dergisine bakar; kilit almaz, başka işlemcinin yazdığı bir satıra
+ * dokunmaz. Yüklü dergi boşalır (ya da dolar) ve önceki de öyleyse ikisi
+ * önbelleğin deposuyla bütün olarak değiş tokuş edilir; kilit ancak bu
+ * noktada, dergi başına bir kez alınır. Depo da boşsa yüklü dergi slab
+ * katmanından tek kilitte yarıya kadar doldurulur; depo dolu dergi
+ * sınırındaysa gelen dergi slablara boşaltılır.
+ *
+ * kmalloc ikinin kuvveti boylu önbelleklerden (16 B - 4 KB) verir, daha
+ * büyük istekler doğrudan sayfa ayırıcıya gider. kfree işaretçinin
+ * sayfasındaki etiketten (pmm_set_tag) slabın derecesini ya da büyük
+ * bloğun derecesini bulur; slab kendi boyuna hizalı olduğundan başlığı
+ * adresin alt bitleri silinerek bulunur.
+ *
+ * Yapıcı (constructor) her nesne için slab oluşurken bir kez çağrılır ve
+ * nesne önbelleğe kurulu haliyle geri verilmelidir. Bu yüzden yapıcılı
+ * önbelleklerde boş liste bağı nesnenin ardındaki ayrı bir sözcüktedir.
+ */
+
+#include "system.h"
+
+#define KMEM_SLAB_MAGIC     0x51AB51AB
+#define KMEM_MAX_SLAB_ORDER 3           // 32 KB
+#define KMEM_MIN_OBJECTS    8           // Slab başına hedeflenen nesne
+#define KMEM_EMPTY_SLABS    1           // Önbellek başına elde tutulan boş slab
+#define KMEM_TAG_ORDER      0x3F
+#define KMEM_CACHE_NOMAGAZINE   0x01    // Dergisiz: her işlem slab katmanında
+
+#define KMEM_BLOCK_SIZE(order)  ((uint32_t)PAGE_SIZE << (order))
+
+typedef struct kmem_slab {
+    // kfree kilitsiz yalnızca bunları okur: sayaçlardan ayrı satırda
+    kmem_cache_t* cache;
+    uint32_t magic;
+
+    struct kmem_slab* prev __attribute__((aligned(CACHE_LINE_SIZE)));
+    struct kmem_slab* next;
+    void* free;
+    uint32_t in_use;
+} kmem_slab_t;
+
+// kmem_cache_t ve dergilerin kendi önbellekleri (statik, açılışta kurulur)
+static kmem_cache_t kmem_cache_cache;
+static kmem_cache_t kmem_magazine_cache;
+static kmem_cache_t* kmalloc_caches[KMALLOC_CLASSES];
+static kmem_cache_t* kmem_caches = NULL;
+
+kmem_cache_t* process_cache = NULL;
+kmem_cache_t* file_cache = NULL;
+
+static inline uint32_t kmem_align_up(uint32_t value, uint32_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+static inline void** kmem_link(kmem_cache_t* cache, void* object) {
+    return (void**)((uint8_t*)object + cache->free_offset);
+}
+
+static void kmem_list_push(kmem_slab_t** list, kmem_slab_t* slab) {
+    slab->prev = NULL;
+    slab->next = *list;
+    if(*list) (*list)->prev = slab;
+    *list = slab;
+}
+
+static void kmem_list_remove(kmem_slab_t** list, kmem_slab_t* slab) {
+    if(slab->prev) slab->prev->next = slab->next;
+    else *list = slab->next;
+    if(slab->next) slab->next->prev = slab->prev;
+}
+
+static kmem_slab_t* kmem_slab_create(kmem_cache_t* cache) {
+    uintptr_t address = pmm_alloc_pages(cache->order, PMM_ZONE_NORMAL);
+    if(!address) return NULL;
+    pmm_set_tag(address, 1u << cache->order, KMEM_TAG_SLAB | cache->order);
+
+    kmem_slab_t* slab = (kmem_slab_t*)address;
+    slab->cache = cache;
+    slab->free = NULL;
+    slab->in_use = 0;
+    slab->magic = KMEM_SLAB_MAGIC;
+
+    // Sondan başa dizilir: boş liste adres sırasıyla verir
+    uint8_t* first = (uint8_t*)address + kmem_align_up(sizeof(kmem_slab_t), cache->align);
+    for(uint32_t i = cache->objects_per_slab; i-- > 0;) {
+        void* object = first + i * cache->object_size;
+        if(cache->constructor) cache->constructor(object);
+        *kmem_link(cache, object) = slab->free;
+        slab->free = object;
+    }
+
+    cache->slabs++;
+    return slab;
+}
+
+static void kmem_slab_destroy(kmem_cache_t* cache, kmem_slab_t* slab) {
+    uintptr_t address = (uintptr_t)slab;
+    slab->magic = 0;
+    pmm_set_tag(address, 1u << cache->order, PMM_TAG_NONE);
+    pmm_free_pages(address, cache->order);
+    cache->slabs--;
+}
+
+// Nesnenin slabı; slab ayırıcıdan gelmeyen işaretçide NULL
+static kmem_slab_t* kmem_slab_of(const void* object) {
+    uint8_t tag = pmm_get_tag((uintptr_t)object);
+    uint32_t order = tag & KMEM_TAG_ORDER;
+    if((tag & ~KMEM_TAG_ORDER) != KMEM_TAG_SLAB || order > KMEM_MAX_SLAB_ORDER) return NULL;
+
+    kmem_slab_t* slab = (kmem_slab_t*)((uintptr_t)object & ~(uintptr_t)(KMEM_BLOCK_SIZE(order) - 1));
+    return slab->magic == KMEM_SLAB_MAGIC ? slab : NULL;
+}
+
+// Slab katmanı: cache->lock tutulurken, kesmeler kapalı çağrılır
+static void* kmem_slab_alloc(kmem_cache_t* cache) {
+    kmem_slab_t* slab = cache->partial;
+    if(!slab && cache->empty) {
+        slab = cache->empty;
+        kmem_list_remove(&cache->empty, slab);
+        cache->empty_slabs--;
+        kmem_list_push(&cache->partial, slab);
+    }
+    if(!slab) {
+        slab = kmem_slab_create(cache);
+        if(!slab) {
+            cache->failures++;
+            return NULL;
+        }
+        kmem_list_push(&cache->partial, slab);
+    }
+
+    void* object = slab->free;
+    slab->free = *kmem_link(cache, object);
+    if(++slab->in_use == cache->objects_per_slab) {
+        kmem_list_remove(&cache->partial, slab);
+        kmem_list_push(&cache->full, slab);
+    }
+    cache->active_objects++;
+    return object;
+}
+
+static void kmem_slab_free(kmem_cache_t* cache, kmem_slab_t* slab, void* object) {
+    *kmem_link(cache, object) = slab->free;
+    slab->free = object;
+    cache->active_objects--;
+
+    if(slab->in_use-- == cache->objects_per_slab) {
+        kmem_list_remove(&cache->full, slab);
+        kmem_list_push(&cache->partial, slab);
+    }
+    if(slab->in_use) return;
+
+    // Boşalan slab: biri elde tutulur, fazlası sayfa ayırıcıya döner
+    kmem_list_remove(&cache->partial, slab);
+    if(cache->empty_slabs < KMEM_EMPTY_SLABS) {
+        kmem_list_push(&cache->empty, slab);
+        cache->empty_slabs++;
+    } else {
+        kmem_slab_destroy(cache, slab);
+    }
+}
+
+static void kmem_empty_slabs_release(kmem_cache_t* cache) {
+    while(cache->empty) {
+        kmem_slab_t* slab = cache->empty;
+        kmem_list_remove(&cache->empty, slab);
+        cache->empty_slabs--;
+        kmem_slab_destroy(cache, slab);
+    }
+}
+
+static void* kmem_cache_alloc_direct(kmem_cache_t* cache) {
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&cache->lock);
+    void* object = kmem_slab_alloc(cache);
+    spin_unlock(&cache->lock);
+    if(enabled) enable_interrupts();
+    return object;
+}
+
+static void kmem_cache_free_direct(kmem_cache_t* cache, kmem_slab_t* slab, void* object) {
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&cache->lock);
+    kmem_slab_free(cache, slab, object);
+    spin_unlock(&cache->lock);
+    if(enabled) enable_interrupts();
+}
+
+// Yüklü dergiden al; boşsa ve önceki doluysa yer değiştir
+static inline void* kmem_magazine_pop(kmem_cpu_cache_t* cpu) {
+    if(!cpu->loaded || cpu->loaded->rounds == 0) {
+        kmem_magazine_t* previous = cpu->previous;
+        if(!previous || previous->rounds == 0) return NULL;
+        cpu->previous = cpu->loaded;
+        cpu->loaded = previous;
+    }
+    return cpu->loaded->objects[--cpu->loaded->rounds];
+}
+
+static inline bool kmem_magazine_push(kmem_cpu_cache_t* cpu, void* object) {
+    if(!cpu->loaded || cpu->loaded->rounds == KMEM_MAGAZINE_ROUNDS) {
+        kmem_magazine_t* previous = cpu->previous;
+        if(!previous || previous->rounds == KMEM_MAGAZINE_ROUNDS) return false;
+        cpu->previous = cpu->loaded;
+        cpu->loaded = previous;
+    }
+    cpu->loaded->objects[cpu->loaded->rounds++] = object;
+    return true;
+}
+
+// Dergideki nesneleri slablarına geri koy (cache->lock tutulurken)
+static void kmem_magazine_flush(kmem_cache_t* cache, kmem_magazine_t* magazine) {
+    while(magazine->rounds) {
+        void* object = magazine->objects[--magazine->rounds];
+        kmem_slab_free(cache, kmem_slab_of(object), object);
+    }
+}
+
+// Depodaki boş dergi ya da yenisi (cache->lock tutulurken; dergi
+// önbelleğinin kilidi hep bundan sonra alınır)
+static kmem_magazine_t* kmem_depot_take_empty(kmem_cache_t* cache) {
+    kmem_magazine_t* magazine = cache->depot_empty;
+    if(magazine) {
+        cache->depot_empty = magazine->next;
+        return magazine;
+    }
+
+    magazine = kmem_cache_alloc_direct(&kmem_magazine_cache);
+    if(magazine) magazine->rounds = 0;
+    return magazine;
+}
+
+static void kmem_magazine_release(kmem_cache_t* cache, kmem_magazine_t* magazine) {
+    kmem_magazine_flush(cache, magazine);
+    kmem_cache_free_direct(&kmem_magazine_cache, kmem_slab_of(magazine), magazine);
+}
+
+// Yerel dergiler boş: depodan dolu dergi al, depo da boşsa yüklü dergiyi
+// slablardan tek kilitte yarıya kadar doldur
+static void* kmem_alloc_slow(kmem_cache_t* cache) {
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    kmem_cpu_cache_t* cpu = &cache->cpu[cpu_current()];
+
+    // Arada bir kesme doldurmuş olabilir
+    void* object = kmem_magazine_pop(cpu);
+    if(!object) {
+        spin_lock(&cache->lock);
+        if(cache->depot_full) {
+            kmem_magazine_t* full = cache->depot_full;
+            cache->depot_full = full->next;
+            cache->depot_full_count--;
+            cache->depot_exchanges++;
+            if(cpu->previous) {
+                cpu->previous->next = cache->depot_empty;
+                cache->depot_empty = cpu->previous;
+            }
+            cpu->previous = cpu->loaded;
+            cpu->loaded = full;
+        } else {
+            if(!cpu->loaded) cpu->loaded = kmem_depot_take_empty(cache);
+            kmem_magazine_t* loaded = cpu->loaded;
+            while(loaded && loaded->rounds < KMEM_MAGAZINE_ROUNDS / 2) {
+                void* extra = kmem_slab_alloc(cache);
+                if(!extra) break;
+                loaded->objects[loaded->rounds++] = extra;
+            }
+        }
+
+        object = kmem_magazine_pop(cpu);
+        if(!object) object = kmem_slab_alloc(cache);
+        spin_unlock(&cache->lock);
+    }
+
+    if(object) cpu->allocations++;
+    if(enabled) enable_interrupts();
+    return object;
+}
+
+// Yerel dergiler dolu: önceki dolu dergi depoya gider, yerine boş dergi
+// yüklenir. Depo sınırdaysa dergi slablara boşaltılıp yeniden kullanılır.
+static void kmem_free_slow(kmem_cache_t* cache, kmem_slab_t* slab, void* object) {
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    kmem_cpu_cache_t* cpu = &cache->cpu[cpu_current()];
+
+    if(!kmem_magazine_push(cpu, object)) {
+        spin_lock(&cache->lock);
+
+        kmem_magazine_t* empty = cpu->previous;
+        if(empty && cache->depot_full_count < KMEM_DEPOT_LIMIT) {
+            empty->next = cache->depot_full;
+            cache->depot_full = empty;
+            cache->depot_full_count++;
+            empty = NULL;
+        }
+        if(empty) kmem_magazine_flush(cache, empty);
+        else empty = kmem_depot_take_empty(cache);
+
+        cache->depot_exchanges++;
+        cpu->previous = cpu->loaded;
+        cpu->loaded = empty;
+        if(!kmem_magazine_push(cpu, object)) kmem_slab_free(cache, slab, object);
+        spin_unlock(&cache->lock);
+    }
+
+    if(enabled) enable_interrupts();
+}
+
+// Hızlı yol: yalnızca bu işlemcinin dergileri; kilit yok
+static void kmem_object_release(kmem_cache_t* cache, kmem_slab_t* slab, void* object) {
+    if(cache->flags & KMEM_CACHE_NOMAGAZINE) {
+        kmem_cache_free_direct(cache, slab, object);
+        return;
+    }
+
+    uintptr_t flags = irq_save();
+    bool cached = kmem_magazine_push(&cache->cpu[cpu_current()], object);
+    irq_restore(flags);
+
+    if(!cached) kmem_free_slow(cache, slab, object);
+}
+
+// İşlemcinin dergilerini ve depoyu boşalt, boş slabları geri ver
+// (cache->lock tutulurken)
+static void kmem_cache_reap(kmem_cache_t* cache, kmem_cpu_cache_t* cpu) {
+    if(cpu) {
+        if(cpu->loaded) kmem_magazine_release(cache, cpu->loaded);
+        if(cpu->previous) kmem_magazine_release(cache, cpu->previous);
+        cpu->loaded = NULL;
+        cpu->previous = NULL;
+    }
+
+    while(cache->depot_full) {
+        kmem_magazine_t* magazine = cache->depot_full;
+        cache->depot_full = magazine->next;
+        kmem_magazine_release(cache, magazine);
+    }
+    cache->depot_full_count = 0;
+    while(cache->depot_empty) {
+        kmem_magazine_t* magazine = cache->depot_empty;
+        cache->depot_empty = magazine->next;
+        kmem_magazine_release(cache, magazine);
+    }
+
+    kmem_empty_slabs_release(cache);
+}
+
+static void kmem_cache_link(kmem_cache_t* cache) {
+    kmem_cache_t** link = &kmem_caches;
+    while(*link) link = &(*link)->next;
+    cache->next = NULL;
+    *link = cache;
+}
+
+// align 0: varsayılan. Küçük nesne boyuna, diğerleri önbellek satırına
+// hizalanır; böylece hiçbir nesne gereksiz yere iki satıra taşmaz.
+static bool kmem_cache_setup(kmem_cache_t* cache, const char* name, uint32_t size, uint32_t align,
+                             void (*constructor)(void*), uint32_t flags) {
+    if(size == 0 || (align & (align - 1))) return false;
+
+    uint32_t natural = CACHE_LINE_SIZE;
+    while(natural > sizeof(void*) && natural / 2 >= size) natural /= 2;
+    if(align < natural) align = natural;
+
+    uint32_t free_offset = 0;
+    uint32_t object_size = size < sizeof(void*) ? sizeof(void*) : size;
+    if(constructor) {
+        free_offset = kmem_align_up(size, sizeof(void*));
+        object_size = free_offset + sizeof(void*);
+    }
+    object_size = kmem_align_up(object_size, align);
+
+    // En az KMEM_MIN_OBJECTS nesne alan en küçük slab
+    uint32_t first = kmem_align_up(sizeof(kmem_slab_t), align);
+    uint32_t order = 0;
+    while(order < KMEM_MAX_SLAB_ORDER && (KMEM_BLOCK_SIZE(order) - first) / object_size < KMEM_MIN_OBJECTS) order++;
+    if(KMEM_BLOCK_SIZE(order) < first + object_size) return false;
+
+    memset(cache, 0, sizeof(kmem_cache_t));
+    ksnprintf(cache->name, KMEM_NAME_LENGTH, "%s", name);
+    cache->size = size;
+    cache->object_size = object_size;
+    cache->align = align;
+    cache->free_offset = free_offset;
+    cache->order = order;
+    cache->objects_per_slab = (KMEM_BLOCK_SIZE(order) - first) / object_size;
+    cache->flags = flags;
+    cache->constructor = constructor;
+    return true;
+}
+
+kmem_cache_t* kmem_cache_create(const char* name, uint32_t size, uint32_t align, void (*constructor)(void*)) {
+    kmem_cache_t* cache = kmem_cache_alloc(&kmem_cache_cache);
+    if(!cache) return NULL;
+
+    if(!kmem_cache_setup(cache, name, size, align, constructor, 0)) {
+        kmem_cache_free(&kmem_cache_cache, cache);
+        return NULL;
+    }
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    kmem_cache_link(cache);
+    if(enabled) enable_interrupts();
+    return cache;
+}
+
+// Kullanımda nesnesi olan önbellek yok edilmez. Önbelleği artık kimse
+// kullanmadığından tüm işlemcilerin dergileri boşaltılabilir.
+void kmem_cache_destroy(kmem_cache_t* cache) {
+    if(!cache || (cache->flags & KMEM_CACHE_NOMAGAZINE)) return;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&cache->lock);
+    for(int cpu = 0; cpu < MAX_CPUS; cpu++) kmem_cache_reap(cache, &cache->cpu[cpu]);
+    bool busy = cache->active_objects != 0;
+    spin_unlock(&cache->lock);
+
+    if(!busy) {
+        kmem_cache_t** link = &kmem_caches;
+        while(*link && *link != cache) link = &(*link)->next;
+        if(*link) *link = cache->next;
+    }
+    if(enabled) enable_interrupts();
+
+    if(!busy) kmem_cache_free(&kmem_cache_cache, cache);
+}
+
+void* kmem_cache_alloc(kmem_cache_t* cache) {
+    if(!cache) return NULL;
+    if(cache->flags & KMEM_CACHE_NOMAGAZINE) return kmem_cache_alloc_direct(cache);
+
+    // Hızlı yol: yalnızca bu işlemcinin dergileri; kilit yok
+    uintptr_t flags = irq_save();
+    kmem_cpu_cache_t* cpu = &cache->cpu[cpu_current()];
+    void* object = kmem_magazine_pop(cpu);
+    if(object) cpu->allocations++;
+    irq_restore(flags);
+
+    return object ? object : kmem_alloc_slow(cache);
+}
+
+void kmem_cache_free(kmem_cache_t* cache, void* object) {
+    if(!cache || !object) return;
+
+    kmem_slab_t* slab = kmem_slab_of(object);
+    if(slab && slab->cache == cache) kmem_object_release(cache, slab, object);
+}
+
+// Bu işlemcinin dergilerini ve depoyu slablara boşaltıp boş slabları
+// sayfa ayırıcıya ver; diğer işlemcilerin dergilerine dokunulmaz
+void kmem_cache_shrink(kmem_cache_t* cache) {
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&cache->lock);
+    kmem_cache_reap(cache, (cache->flags & KMEM_CACHE_NOMAGAZINE) ? NULL : &cache->cpu[cpu_current()]);
+    spin_unlock(&cache->lock);
+    if(enabled) enable_interrupts();
+}
+
+kmem_cache_t* kmem_cache_first() {
+    return kmem_caches;
+}
+
+// Dergilerde bekleyen nesneler (istatistik; kilitsiz okunur)
+uint32_t kmem_cache_cached(const kmem_cache_t* cache) {
+    uint32_t rounds = cache->depot_full_count * KMEM_MAGAZINE_ROUNDS;
+    for(int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        const kmem_cpu_cache_t* local = &cache->cpu[cpu];
+        if(local->loaded) rounds += local->loaded->rounds;
+        if(local->previous) rounds += local->previous->rounds;
+    }
+    return rounds;
+}
+
+void* kmalloc(uint32_t size) {
+    if(size == 0) return NULL;
+
+    if(size <= (1u << KMALLOC_MAX_SHIFT)) {
+        uint32_t shift = KMALLOC_MIN_SHIFT;
+        while((1u << shift) < size) shift++;
+        return kmem_cache_alloc(kmalloc_caches[shift - KMALLOC_MIN_SHIFT]);
+    }
+
+    // Büyük istek: sayfa bloğu, derecesi baş sayfanın etiketinde
+    uint32_t order = 0;
+    while(order <= PMM_MAX_ORDER && KMEM_BLOCK_SIZE(order) < size) order++;
+    if(order > PMM_MAX_ORDER) return NULL;
+
+    uintptr_t address = pmm_alloc_pages(order, PMM_ZONE_NORMAL);
+    if(address) pmm_set_tag(address, 1, KMEM_TAG_LARGE | order);
+    return (void*)address;
+}
+
+void kfree(void* ptr) {
+    if(!ptr) return;
+
+    uintptr_t address = (uintptr_t)ptr;
+    uint8_t tag = pmm_get_tag(address);
+    if((tag & ~KMEM_TAG_ORDER) == KMEM_TAG_LARGE) {
+        if(address % PAGE_SIZE) return;
+        pmm_set_tag(address, 1, PMM_TAG_NONE);
+        pmm_free_pages(address, tag & KMEM_TAG_ORDER);
+        return;
+    }
+
+    kmem_slab_t* slab = kmem_slab_of(ptr);
+    if(slab) kmem_object_release(slab->cache, slab, ptr);
+}
+
+void kmalloc_init() {
+    kmem_caches = NULL;
+    kmem_cache_setup(&kmem_cache_cache, "kmem_cache", sizeof(kmem_cache_t), 0, NULL, KMEM_CACHE_NOMAGAZINE);
+    kmem_cache_setup(&kmem_magazine_cache, "magazine", sizeof(kmem_magazine_t), 0, NULL, KMEM_CACHE_NOMAGAZINE);
+    kmem_cache_link(&kmem_cache_cache);
+    kmem_cache_link(&kmem_magazine_cache);
+
+    for(int i = 0; i < KMALLOC_CLASSES; i++) {
+        char name[KMEM_NAME_LENGTH];
+        uint32_t size = 1u << (i + KMALLOC_MIN_SHIFT);
+        ksnprintf(name, sizeof(name), "kmalloc-%u", size);
+        kmalloc_caches[i] = kmem_cache_create(name, size, 0, NULL);
+    }
+
+    // Sık ayrılan çekirdek nesneleri
+    process_cache = kmem_cache_create("process", sizeof(process_t), 0, NULL);
+    file_cache = kmem_cache_create("file", sizeof(file_t), 0, NULL);
+}
@@ -0,0 +1,7 @@
+#ifndef _STDBOOL_H
+#define _STDBOOL_H
+
+// bool, true ve false system.h içinde tanımlıdır
+#include "system.h"
+
+#endif
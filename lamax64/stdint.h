@@ -0,0 +1,7 @@
+#ifndef _STDINT_H
+#define _STDINT_H
+
+// Sabit genişlikli tipler system.h içinde tanımlıdır
+#include "system.h"
+
+#endif
@@ -16,6 +16,13 @@ typedef signed char int8_t;
 typedef signed short int16_t;
 typedef signed int int32_t;
 typedef signed long long int64_t;
+typedef unsigned long uintptr_t;
+
+// Değişken argüman listesi (derleyici yerleşikleri)
+typedef __builtin_va_list va_list;
+#define va_start(ap, last)  __builtin_va_start(ap, last)
+#define va_arg(ap, type)    __builtin_va_arg(ap, type)
+#define va_end(ap)          __builtin_va_end(ap)
 
 // Boolean tip
 typedef enum { false = 0, true = 1 } bool;
@@ -29,7 +36,17 @@ typedef enum { false = 0, true = 1 } bool;
 #define VGA_BUFFER          0xB8000
 #define KERNEL_START        0x100000
 #define STACK_BASE          0x200000
-#define HEAP_START          0x300000
+#define BOOT_PROFILE_ADDR   0x0500
+#define E820_MAP_ADDR       0x0600
+#define SHELL_LOAD_ADDR     0x10000     // disk.ld ile disk.bin'in üst sınırı
+#define BOOT_LAYOUT_ADDR    0x7DEE      // Bellekteki MBR, imzanın hemen önü
+
+// VGA metin modu boyutları
+#define VGA_WIDTH           80
+#define VGA_HEIGHT          25
+
+// Konsol geçmişi (scrollback) satır sayısı
+#define CONSOLE_HISTORY_LINES   4096
 
 // VGA renk kodları
 #define VGA_COLOR_BLACK         0
@@ -55,6 +72,7 @@ typedef enum { false = 0, true = 1 } bool;
 #define MAX_PATH_LENGTH     256
 #define MAX_FILENAME        64
 #define PAGE_SIZE           4096
+#define MAX_CPUS            16
 #define SECTOR_SIZE         512
 
 // Hata kodları
@@ -85,6 +103,38 @@ typedef struct process {
     struct process* next;
 } process_t;
 
+// Sıralı okuma önsezisi (açık dosya başına). Ardışık erişimde pencere
+// READAHEAD_MIN_BLOCKS'tan READAHEAD_MAX_BLOCKS'a ikiye katlanarak büyür;
+// okuyucu son pencerenin başına gelince bir sonraki asenkron başlar.
+#define READAHEAD_MIN_BLOCKS    4       // 16 KB
+#define READAHEAD_MAX_BLOCKS    256     // 1 MB
+
+typedef struct {
+    uint64_t next;          // Ardışık okumada beklenen mantıksal blok
+    uint64_t start;         // Son pencerenin ilk bloğu
+    uint32_t size;          // Son pencere (blok); 0: pencere yok
+} readahead_t;
+
+// Mantıksal bloğun aygıt bloğu; dönüş: bitişik blok sayısı (0: dosya sonu)
+typedef uint32_t (*readahead_map_t)(void* context, uint64_t index, uint64_t* block);
+
+// Sanal dosya sistemi düğümü; id dosya sistemine özgüdür (FAT: ilk küme)
+struct vfs_mount;
+
+typedef struct vfs_node {
+    struct vfs_mount* mount;
+    uint64_t id;
+    uint32_t size;
+    uint32_t attributes;
+    bool is_directory;
+} vfs_node_t;
+
+typedef struct {
+    char name[MAX_FILENAME];
+    uint32_t size;
+    bool is_directory;
+} vfs_dirent_t;
+
 // Dosya yapısı
 typedef struct file {
     char name[MAX_FILENAME];
@@ -94,22 +144,415 @@ typedef struct file {
     uint32_t last_access;
     uint32_t data_offset;
     bool is_directory;
+    readahead_t readahead;
+
+    bool in_use;
+    vfs_node_t node;
+    struct dentry* dentry;      // Açıldığı dizin girdisi (sabitlenmiş), yoksa NULL
+    uint32_t position;          // Dosyada okuma konumu (dizinde girdi konumu)
+    uint64_t cursor_index;      // Dosya sistemi: son eşlenen mantıksal konum
+    uint64_t cursor_block;      // ve karşılığı (FAT: küme); 0 geçersiz
 } file_t;
 
-// Bellek bloku yapısı
-typedef struct memory_block {
-    uint32_t address;
-    uint32_t size;
-    bool is_free;
-    struct memory_block* next;
-} memory_block_t;
+// Konsol hedefi (sink) yapısı
+#define CONSOLE_SINK_VGA        0x01
+#define CONSOLE_SINK_SERIAL     0x02
+
+// Açılışta etkin olan konsol hedefleri
+#ifndef KERNEL_CONSOLE_SINKS
+#define KERNEL_CONSOLE_SINKS    (CONSOLE_SINK_VGA | CONSOLE_SINK_SERIAL)
+#endif
+
+typedef struct console_sink {
+    const char* name;
+    uint32_t id;
+    bool enabled;
+    void (*write)(const char* buffer, int length, uint8_t color);
+    void (*flush)();
+    struct console_sink* next;
+} console_sink_t;
+
+// İstisna çerçevesi (isr.asm itme sırasının tersi)
+typedef struct {
+    uint64_t r15, r14, r13, r12, r11, r10, r9, r8;
+    uint64_t rbp, rdi, rsi, rdx, rcx, rbx, rax;
+    uint64_t vector;
+    uint64_t error_code;
+    uint64_t rip, cs, rflags, rsp, ss;
+} interrupt_frame_t;
+
+// Son tarihli zamanlayıcı
+typedef struct ktimer {
+    uint64_t deadline;
+    void (*callback)(void* arg);
+    void* arg;
+    bool active;
+    struct ktimer* next;
+} ktimer_t;
+
+// Blok aygıt isteği (status: BLOCK_PENDING, tamamlanınca 0 ya da -1)
+#define BLOCK_SECTOR_SIZE   512
+#define BLOCK_PENDING       1
+
+struct block_device;
+
+typedef struct block_request {
+    uint64_t lba;
+    uint32_t count;
+    void* buffer;
+    bool write;
+    volatile int status;
+    void (*complete)(struct block_request* request);
+    void* private_data;
+    struct block_request* next;
+
+    // Zamanlayıcı alanları (block_submit doldurur)
+    struct block_device* device;
+    uint64_t deadline;                  // Bu zamandan sonra sıra beklemez (ns)
+    struct block_request* fifo_next;    // Varış sırası
+} block_request_t;
+
+// İstek kuyruğu: bekleyenler LBA sırasında (asansör) ve varış sırasında
+// (deadline) tutulur; komşu istekler tek sürücü isteğinde birleşir.
+#define BLOCK_QUEUE_DEPTH       32
+#define BLOCK_READ_DEADLINE_MS  50
+#define BLOCK_WRITE_DEADLINE_MS 500
+
+typedef struct block_queue {
+    block_request_t* sorted;
+    block_request_t* fifo_head;
+    block_request_t* fifo_tail;
+    uint64_t position;                  // Son gönderilen isteğin sonu (LBA)
+    uint32_t depth;                     // Sürücüde aynı anda en fazla istek
+    uint32_t in_flight;
+    bool running;
+    bool rerun;
+
+    // Sürücüye giden istekler; birleşen istekler private_data'da zincir
+    block_request_t slots[BLOCK_QUEUE_DEPTH];
+    block_request_t* free_slots;
+
+    uint32_t submitted;
+    uint32_t dispatched;
+    uint32_t merged;
+} block_queue_t;
+
+// Blok aygıt: submit bir istek listesini kuyruğa alır, tamamlanınca
+// her isteğin complete'i çağrılır (kesme bağlamında olabilir). Kesme
+// gelmeyecekse (interrupt_driven false) bekleme döngüsü poll'u çağırır.
+// queue_depth sürücünün aynı anda kabul ettiği istek sayısıdır.
+typedef struct block_device {
+    const char* name;
+    uint64_t sectors;
+    uint32_t max_sectors;
+    uint32_t queue_depth;
+    bool interrupt_driven;
+    int (*submit)(struct block_device* device, block_request_t* requests);
+    int (*flush)(struct block_device* device);
+    void (*poll)(struct block_device* device);
+    void* driver_data;
+    struct block_device* next;
+    block_queue_t queue;
+} block_device_t;
+
+// Tampon önbelleği: (aygıt, blok) anahtarlı 4 KB bloklar, LRU ile
+// çıkarma, kirli bloklar flush aralığında arka planda yazılır
+#define BCACHE_BLOCK_SIZE           4096
+#define BCACHE_BLOCK_SECTORS        (BCACHE_BLOCK_SIZE / BLOCK_SECTOR_SIZE)
+#define BCACHE_BLOCKS               1024
+#define BCACHE_HASH_BITS            7
+#define BCACHE_HASH_SIZE            (1 << BCACHE_HASH_BITS)
+#define BCACHE_FLUSH_INTERVAL_MS    5000
+
+#define BUFFER_VALID        0x01    // Veri diskle eşleşiyor ya da daha yeni
+#define BUFFER_DIRTY        0x02    // Yazılmayı bekliyor
+#define BUFFER_WRITEBACK    0x04    // Yazma isteği sürücüde
+#define BUFFER_READING      0x08    // Önden okuma isteği sürücüde
+
+typedef struct buffer {
+    block_device_t* device;
+    uint64_t block;
+    uint8_t* data;
+    volatile uint32_t flags;
+    uint32_t refcount;
+    struct buffer* hash_next;
+    struct buffer* lru_prev;        // lru_prev yönü en son kullanılana
+    struct buffer* lru_next;
+    block_request_t request;
+} buffer_t;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t writebacks;
+    uint32_t write_errors;
+    uint32_t readahead;
+    uint32_t dirty;
+} bcache_stats_t;
+
+// Dosya sistemi türü: mount aygıtı tanırsa kök düğümü doldurur.
+// readdir dizin dosyasının konumundan bir girdi okur (1), sonda 0 döner.
+// Salt okunur türlerde create/write/unlink NULL'dır. open/release isteğe
+// bağlıdır; düğümü açık dosyalar varken tutması gereken türler kullanır.
+#define VFS_MAX_MOUNTS      8
+#define VFS_MOUNT_PATH      64
+
+typedef struct vfs_ops {
+    const char* name;
+    bool (*mount)(struct vfs_mount* mount);
+    int (*lookup)(struct vfs_mount* mount, const vfs_node_t* dir, const char* name, vfs_node_t* node);
+    int (*readdir)(struct vfs_mount* mount, file_t* dir, vfs_dirent_t* entry);
+    int (*read)(struct vfs_mount* mount, file_t* file, void* buffer, uint32_t size);
+    int (*create)(struct vfs_mount* mount, const vfs_node_t* dir, const char* name, bool is_directory, vfs_node_t* node);
+    int (*write)(struct vfs_mount* mount, file_t* file, const void* buffer, uint32_t size);
+    int (*unlink)(struct vfs_mount* mount, const vfs_node_t* dir, const char* name);
+    int (*open)(struct vfs_mount* mount, const vfs_node_t* node);
+    void (*release)(struct vfs_mount* mount, const vfs_node_t* node);
+    struct vfs_ops* next;
+} vfs_ops_t;
+
+typedef struct vfs_mount {
+    char path[VFS_MOUNT_PATH];
+    vfs_ops_t* ops;
+    block_device_t* device;
+    vfs_node_t root;
+    void* fs_data;
+} vfs_mount_t;
+
+// Dizin girdisi önbelleği: (bağlama, üst dizin, ad) -> düğüm. Negatif
+// girdi adın olmadığını kaydeder. Açık dosyaların girdileri sabitlenir.
+#define DCACHE_ENTRIES      512
+#define DCACHE_HASH_BITS    8
+#define DCACHE_HASH_SIZE    (1 << DCACHE_HASH_BITS)
+
+typedef struct dentry {
+    vfs_mount_t* mount;         // NULL: boş
+    uint64_t parent;            // Üst dizin düğümünün id'si
+    uint32_t hash;
+    char name[MAX_FILENAME];
+    vfs_node_t node;
+    bool negative;
+    bool hashed;
+    uint32_t refcount;
+
+    struct dentry* hash_next;
+    struct dentry* lru_prev;
+    struct dentry* lru_next;
+} dentry_t;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t negative_hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t entries;
+} dcache_stats_t;
+
+// Bellek içi dosya sistemi (tmpfs): sayfalar PMM'den, düğümler slab'dan,
+// dosya verisi dosya başına bir radix ağacında (ara düğümler de birer sayfa)
+#define TMPFS_RADIX_SHIFT   (sizeof(void*) == 8 ? 9 : 10)
+#define TMPFS_RADIX_SLOTS   (1u << TMPFS_RADIX_SHIFT)
+
+// Açılış profili (0x0500, boot.asm ile aynı yerleşim)
+#define BOOT_PROFILE_MAGIC      0x464F5250      // 'PROF'
+#define BOOT_MARK_COUNT         28
+
+// Aşama işaretleri (marks[] indeksleri)
+#define BOOT_MARK_MBR_START     0
+#define BOOT_MARK_MBR_DISK      1
+#define BOOT_MARK_MBR_LOADED    2
+#define BOOT_MARK_DISK_MAIN     3
+#define BOOT_MARK_SHELL_LOADED  4
+#define BOOT_MARK_SHELL_MAIN    5
+#define BOOT_MARK_KERNEL_LOADED 6
+#define BOOT_MARK_KERNEL_MAIN   7
+#define BOOT_MARK_CONSOLE_READY 8
+#define BOOT_MARK_IRQ_READY     9
+#define BOOT_MARK_TIMER_READY   10
+#define BOOT_MARK_INIT_DONE     11
+#define BOOT_MARK_PROMPT        12
 
+// Süre kategorileri
+#define BOOT_PROFILE_DISK       0
+#define BOOT_PROFILE_DELAY      1
+#define BOOT_PROFILE_CONSOLE    2
+
+typedef struct {
+    uint32_t magic;
+    uint32_t finished;
+    uint64_t disk_cycles;
+    uint64_t delay_cycles;
+    uint64_t console_cycles;
+    uint64_t marks[BOOT_MARK_COUNT];
+} __attribute__((packed)) boot_profile_t;
+
+// Açılış diski yerleşimi (LBA, sektör). Makefile ikili boyutlarından
+// layout.inc'i üretir, boot.asm onu MBR'nin sonuna gömer; sonraki
+// aşamalar bellekte 0x7C00'da duran MBR'den okur.
+typedef struct {
+    uint32_t shell_lba;
+    uint32_t shell_sectors;
+    uint32_t kernel_lba;
+    uint32_t kernel_sectors;
+} __attribute__((packed)) boot_layout_t;
+
+// BIOS bellek haritası (0x0600, boot.asm ile aynı yerleşim)
+#define E820_MAX_ENTRIES    64
+#define E820_USABLE         1
+#define E820_RESERVED       2
+#define E820_ACPI           3
+#define E820_NVS            4
+#define E820_BAD            5
+
+typedef struct {
+    uint64_t base;
+    uint64_t length;
+    uint32_t type;
+    uint32_t attributes;        // ACPI 3.0; eski BIOS'larda tanımsız
+} __attribute__((packed)) e820_entry_t;
+
+typedef struct {
+    uint16_t count;
+    uint16_t reserved[3];
+    e820_entry_t entries[E820_MAX_ENTRIES];
+} __attribute__((packed)) e820_map_t;
+
+// Fiziksel sayfa ayırıcı: bölge başına ikili eş (buddy) ayırıcı,
+// 2^0..2^PMM_MAX_ORDER sayfalık bloklar. Adresler fizikseldir ve birebir
+// eşlenir; 0 başarısızlık demektir (ilk 1 MB hiç verilmez).
+#define PMM_ZONE_DMA        0           // < 16 MB, ISA DMA erişebilir
+#define PMM_ZONE_NORMAL     1
+#define PMM_ZONES           2
+#define PMM_DMA_LIMIT       0x1000000
+#define PMM_MAX_ORDER       10          // 4 MB
+
+typedef struct {
+    uint64_t installed;                 // E820'deki kullanılabilir toplam bayt
+    uint32_t total_pages[PMM_ZONES];
+    uint32_t free_pages[PMM_ZONES];
+    uint32_t free_blocks[PMM_ZONES][PMM_MAX_ORDER + 1];
+} pmm_stats_t;
+
+// Ayrılmış sayfaya sahibinin yazabildiği etiket (pmm_set_tag).
+// PMM_MAX_ORDER'ın üstünde olmalı: küçük değerler boş blok başıdır.
+#define PMM_TAG_NONE        0xFF
+
+// Sanal bellek: 4 düzeyli sayfalama. Fiziksel bellek VMM_DIRECT_BASE'ten
+// itibaren 1 GB (işlemci desteklemiyorsa 2 MB) sayfalarla doğrudan
+// eşlenir; PML4'ün ilk girişi aynı PDPT'yi paylaşarak birebir pencereyi
+// korur. vmalloc alanı 4 KB sayfalarla, isteğe göre doldurulur.
+#define VMM_DIRECT_BASE     0xFFFF800000000000ULL
+#define VMM_DIRECT_MAX      0x8000000000ULL         // 512 GB, tek PDPT
+#define VMM_VMALLOC_BASE    0xFFFFC90000000000ULL
+#define VMM_VMALLOC_SIZE    0x40000000ULL           // 1 GB
+#define VMM_TLB_BATCH       32                      // Üstünde CR3 yeniden yüklenir
+
+// Sayfa tablosu girdisi bitleri (vmm_map bayrakları)
+#define VMM_PRESENT         0x001
+#define VMM_WRITE           0x002
+#define VMM_WRITE_THROUGH   0x008
+#define VMM_NOCACHE         0x010
+#define VMM_HUGE            0x080
+#define VMM_GLOBAL          0x100
+
+typedef struct {
+    uint64_t mapped_limit;              // Doğrudan eşlemin sonu
+    uint32_t direct_page_size;          // 2 MB ya da 1 GB
+    bool global_pages;                  // CR4.PGE
+    uint32_t table_pages;               // vmm_map'in ayırdığı ara tablolar
+    uint32_t vmalloc_areas;
+    uint32_t vmalloc_pages;
+    uint64_t invlpg_count;
+    uint64_t full_flushes;
+} vmm_stats_t;
+
+// Slab ayırıcı. kmalloc 16 B - 4 KB arası ikinin kuvveti sınıflardan
+// verir, daha büyüğü doğrudan sayfa ayırıcıdan gelir.
+#define CACHE_LINE_SIZE     64
+#define KMALLOC_MIN_SHIFT   4           // 16 B
+#define KMALLOC_MAX_SHIFT   12          // 4 KB
+#define KMALLOC_CLASSES     (KMALLOC_MAX_SHIFT - KMALLOC_MIN_SHIFT + 1)
+#define KMEM_NAME_LENGTH    16
+#define KMEM_TAG_LARGE      0x80        // | derece: kmalloc büyük blok başı
+#define KMEM_TAG_SLAB       0xC0        // | derece: slab'ın her sayfası
+
+// Her işlemcinin önünde iki dergi (magazine): boş nesne yığınları.
+// Dergiler depoyla bütün olarak değiş tokuş edilir.
+#define KMEM_MAGAZINE_ROUNDS    30
+#define KMEM_DEPOT_LIMIT        8       // Depoda bekleyen dolu dergi sınırı
+
+// Kesmeleri kapatmayan döngü kilidi; çağıran kapatır
+typedef struct {
+    volatile uint32_t locked;
+} spinlock_t;
+
+struct kmem_slab;
+
+typedef struct kmem_magazine {
+    uint32_t rounds;
+    struct kmem_magazine* next;
+    void* objects[KMEM_MAGAZINE_ROUNDS];
+} kmem_magazine_t;
+
+// Yalnızca sahibi olan işlemci yazar; ayrı önbellek satırında
+typedef struct {
+    kmem_magazine_t* loaded;
+    kmem_magazine_t* previous;
+    uint32_t allocations;
+} __attribute__((aligned(CACHE_LINE_SIZE))) kmem_cpu_cache_t;
+
+typedef struct kmem_cache {
+    kmem_cpu_cache_t cpu[MAX_CPUS];
+    char name[KMEM_NAME_LENGTH];
+    uint32_t size;              // İstenen nesne boyu
+    uint32_t object_size;       // Hizalanmış nesne adımı
+    uint32_t align;
+    uint32_t free_offset;       // Boş nesnede sonraki bağın yeri
+    uint32_t order;             // Slab 2^order sayfa
+    uint32_t objects_per_slab;
+    uint32_t flags;
+    void (*constructor)(void* object);
+
+    // Depo ve slab katmanı; lock altında
+    spinlock_t lock;
+    kmem_magazine_t* depot_full;
+    kmem_magazine_t* depot_empty;
+    uint32_t depot_full_count;
+    uint32_t depot_exchanges;
+    struct kmem_slab* partial;
+    struct kmem_slab* full;
+    struct kmem_slab* empty;
+    uint32_t empty_slabs;
+    uint32_t slabs;
+    uint32_t active_objects;    // Slablardan çıkmış (dergilerdekiler dahil)
+    uint32_t failures;
+    struct kmem_cache* next;
+} kmem_cache_t;
 // Fonksiyon prototiplerileri
 
 // Temel I/O fonksiyonları
 void kprint(const char* str);
 void kprint_colored(const char* str, uint8_t color);
 void kprintf(const char* format, ...);
+int ksnprintf(char* buffer, uint32_t size, const char* format, ...);
+int kvsnprintf(char* buffer, uint32_t size, const char* format, va_list args);
+
+// Konsol fonksiyonları
+void console_init(uint8_t color);
+void console_set_color(uint8_t color);
+void console_clear();
+void console_putc(char c, uint8_t color);
+void console_write(const char* buffer, int length);
+void console_write_colored(const char* buffer, int length, uint8_t color);
+void console_register_sink(console_sink_t* sink);
+void console_select_sinks(uint32_t mask);
+void console_backspace();
+void console_flush();
+void console_set_history(uint16_t (*rows)[VGA_WIDTH], int count);
+void console_scroll_view(int lines);
+void console_page_up();
+void console_page_down();
 
 // String fonksiyonları
 int strlen(const char* str);
@@ -134,16 +577,139 @@ void schedule_processes();
 
 // Dosya sistemi
 file_t* open_file(const char* filename);
+file_t* create_file(const char* filename);
 void close_file(file_t* file);
 int read_file(file_t* file, void* buffer, uint32_t size);
 int write_file(file_t* file, const void* buffer, uint32_t size);
 bool create_directory(const char* dirname);
 bool delete_file(const char* filename);
+int read_directory(file_t* dir, vfs_dirent_t* entry);
 
 // Interrupt fonksiyonları
+#define IDT_ENTRIES         256
+#define IRQ_BASE            32
+void interrupt_init();
 void enable_interrupts();
 void disable_interrupts();
 void register_interrupt_handler(int interrupt, void (*handler)());
+interrupt_frame_t* interrupt_current_frame();
+bool interrupt_apic_enabled();
+int interrupt_alloc_vectors(int count);
+void interrupt_msi_message(uint8_t vector, int cpu, uint32_t* address, uint32_t* data);
+
+// İşlemciler (yalnızca çalışır durumdakiler; şimdilik BSP)
+int cpu_count();
+int cpu_current();
+
+// Klavye (PS/2, IRQ1)
+void keyboard_init();
+void keyboard_set_idle(void (*idle)());
+char keyboard_getc();
+int keyboard_readline(char* buffer, int max_len);
+uint32_t keyboard_dropped_count();
+
+// Zaman fonksiyonları
+#define TIMER_HZ            1000
+#define TIMER_PERIOD_NS     (1000000000ULL / TIMER_HZ)
+uint64_t div_u64(uint64_t dividend, uint32_t divisor);
+bool tsc_calibrate();
+void tsc_set_frequency(uint64_t hz);
+void tsc_set_boot(uint64_t tsc);
+void tsc_set_idle(void (*idle)());
+uint64_t tsc_frequency();
+uint64_t tsc_to_ns(uint64_t cycles);
+uint64_t ktime_ns();
+void ksleep_until(uint64_t deadline_ns);
+void ksleep_us(uint32_t us);
+void ksleep_ms(uint32_t ms);
+void timer_init();
+uint64_t timer_get_ticks();
+void ktimer_start(ktimer_t* timer, uint32_t delay_us, void (*callback)(void* arg), void* arg);
+bool ktimer_cancel(ktimer_t* timer);
+uint64_t kdeadline_us(uint32_t timeout_us);
+bool ktime_expired(uint64_t deadline_ns);
+
+// Blok aygıtlar
+void block_register(block_device_t* device);
+block_device_t* block_find(const char* name);
+block_device_t* block_first();
+int block_submit(block_device_t* device, block_request_t* requests);
+void block_wait(block_device_t* device, block_request_t* request);
+int block_flush(block_device_t* device);
+int block_read(block_device_t* device, uint64_t lba, uint32_t count, void* buffer);
+int block_write(block_device_t* device, uint64_t lba, uint32_t count, const void* buffer);
+
+// Tampon önbelleği
+void bcache_init();
+buffer_t* bcache_get(block_device_t* device, uint64_t block);
+buffer_t* bcache_read(block_device_t* device, uint64_t block);
+void bcache_dirty(buffer_t* buffer);
+void bcache_release(buffer_t* buffer);
+int bcache_sync(block_device_t* device);
+void bcache_set_flush_interval(uint32_t interval_ms);
+void bcache_idle();
+void bcache_get_stats(bcache_stats_t* stats);
+uint32_t bcache_prefetch(block_device_t* device, uint64_t block, uint32_t count);
+void readahead_init(readahead_t* ra);
+uint32_t readahead_map_linear(void* context, uint64_t index, uint64_t* block);
+void readahead_access(readahead_t* ra, block_device_t* device, uint64_t index, uint32_t count,
+                      uint64_t end, readahead_map_t map, void* context);
+
+// Sanal dosya sistemi
+void vfs_register_filesystem(vfs_ops_t* ops);
+bool vfs_normalize_path(const char* path, char* out);
+int vfs_mount(const char* path, const char* type, block_device_t* device);
+vfs_mount_t* vfs_get_mount(int index);
+int vfs_resolve(const char* path, vfs_node_t* node);
+void fat_init();
+void dcache_init();
+dentry_t* dcache_lookup(vfs_mount_t* mount, uint64_t parent, const char* name);
+dentry_t* dcache_add(vfs_mount_t* mount, uint64_t parent, const char* name, const vfs_node_t* node);
+void dcache_invalidate_dir(vfs_mount_t* mount, uint64_t dir);
+void dcache_get(dentry_t* dentry);
+void dcache_put(dentry_t* dentry);
+void dcache_get_stats(dcache_stats_t* stats);
+void lamaxfs_init();
+void tmpfs_init();
+void tmpfs_usage(uint32_t* pages_used, uint32_t* nodes_used);
+
+// Fiziksel bellek
+void pmm_init();
+uintptr_t pmm_alloc_pages(uint32_t order, int zone);
+void pmm_free_pages(uintptr_t address, uint32_t order);
+uintptr_t pmm_alloc_page(int zone);
+void pmm_free_page(uintptr_t page);
+uintptr_t pmm_alloc_contiguous(uint32_t count, uint32_t align, int zone);
+void pmm_free_contiguous(uintptr_t base, uint32_t count);
+const e820_map_t* pmm_memory_map();
+void pmm_get_stats(pmm_stats_t* stats);
+void pmm_set_tag(uintptr_t address, uint32_t count, uint8_t tag);
+uint8_t pmm_get_tag(uintptr_t address);
+
+// Sanal bellek
+void vmm_init();
+uint64_t vmm_mapped_limit();
+int vmm_map(uintptr_t virt, uintptr_t phys, uint32_t count, uint32_t flags);
+void vmm_unmap(uintptr_t virt, uint32_t count);
+uintptr_t vmm_translate(uintptr_t virt);
+void* vmalloc(uint32_t size);
+void vfree(void* ptr);
+void vmm_get_stats(vmm_stats_t* stats);
+
+// Slab ayırıcı
+void kmalloc_init();
+kmem_cache_t* kmem_cache_create(const char* name, uint32_t size, uint32_t align, void (*constructor)(void*));
+void kmem_cache_destroy(kmem_cache_t* cache);
+void* kmem_cache_alloc(kmem_cache_t* cache);
+void kmem_cache_free(kmem_cache_t* cache, void* object);
+void kmem_cache_shrink(kmem_cache_t* cache);
+kmem_cache_t* kmem_cache_first();
+uint32_t kmem_cache_cached(const kmem_cache_t* cache);
+
+// Açılış profili
+void boot_profile_mark(uint32_t id);
+void boot_profile_add(uint32_t category, uint64_t cycles);
+void boot_profile_finish();
 
 // Sistem çağrıları
 int sys_exit(int status);
@@ -152,6 +718,14 @@ int sys_exec(const char* program);
 int sys_wait(int* status);
 int sys_kill(int pid, int signal);
 
+// Seri port (16550 UART)
+#define COM1_PORT           0x3F8
+bool serial_init(uint16_t port);
+void serial_write(const char* buffer, int length);
+void serial_flush();
+void serial_irq_init();
+bool serial_console_init();
+
 // Port I/O
 uint8_t inb(uint16_t port);
 void outb(uint16_t port, uint8_t data);
@@ -159,6 +733,8 @@ uint16_t inw(uint16_t port);
 void outw(uint16_t port, uint16_t data);
 uint32_t inl(uint16_t port);
 void outl(uint16_t port, uint32_t data);
+void insw(uint16_t port, void* buffer, uint32_t count);
+void outsw(uint16_t port, const void* buffer, uint32_t count);
 
 // Makrolar
 #define CLI() __asm__ volatile("cli")
@@ -171,6 +747,7 @@ void outl(uint16_t port, uint32_t data);
     kprint_colored("KERNEL PANIC: ", VGA_COLOR_LIGHT_RED); \
     kprint(msg); \
     kprint("\nSystem halted.\n"); \
+    serial_flush(); \
     while(1) HLT(); \
 } while(0)
 
@@ -190,11 +767,51 @@ static inline uint16_t make_vga_entry(char c, uint8_t color) {
     return (uint16_t)c | ((uint16_t)color << 8);
 }
 
+static inline void spin_lock(spinlock_t* lock) {
+    while(__sync_lock_test_and_set(&lock->locked, 1)) {
+        while(lock->locked) __asm__ volatile("pause");
+    }
+}
+
+static inline void spin_unlock(spinlock_t* lock) {
+    __sync_lock_release(&lock->locked);
+}
+
+// Yerel kesme bayrağını EFLAGS'ta sakla; interrupts_enabled'a yazmaz.
+// Arada kesme durumunu kendisi yöneten (disable_interrupts) kod çağrılmamalı.
+static inline uintptr_t irq_save() {
+    uintptr_t flags;
+    __asm__ volatile("pushf; pop %0; cli" : "=r"(flags) : : "memory");
+    return flags;
+}
+
+static inline void irq_restore(uintptr_t flags) {
+    if(flags & 0x200) __asm__ volatile("sti" : : : "memory");
+}
+
+// Doğrudan eşlem üzerinden fiziksel <-> sanal; vmalloc adresleri için
+// vmm_translate kullanılmalı
+static inline void* phys_to_virt(uintptr_t phys) {
+    return (void*)(phys + (uintptr_t)VMM_DIRECT_BASE);
+}
+
+static inline uintptr_t virt_to_phys(const void* virt) {
+    return (uintptr_t)virt - (uintptr_t)VMM_DIRECT_BASE;
+}
+
+static inline uint64_t rdtsc() {
+    uint32_t low, high;
+    __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+    return ((uint64_t)high << 32) | low;
+}
+
 // Global değişkenler (extern)
 extern volatile char* vga_buffer;
 extern int cursor_x, cursor_y;
 extern process_t* current_process;
 extern process_t* process_list;
+extern kmem_cache_t* process_cache;
+extern kmem_cache_t* file_cache;
 extern bool interrupts_enabled;
 
 #endif // SYSTEM_H
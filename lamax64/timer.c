@@ -0,0 +1,144 @@
+/*
+ * LAMAX64 OS - Zamanlayıcı
+ * Version 1.0.0
+ *
+ * TSC, ACPI HPET varsa onunla, yoksa PIT ile kalibre edilir. PIT
+ * kanal 0 TIMER_HZ frekansında IRQ0 üretir: bekleyenler HLT'den
+ * uyanır ve süresi dolan son tarihli zamanlayıcılar çalıştırılır.
+ */
+
+#include "system.h"
+#include "acpi.h"
+
+#define PIT_CHANNEL0        0x40
+#define PIT_COMMAND         0x43
+#define PIT_FREQUENCY       1193182
+#define TIMER_IRQ           0
+
+// HPET yazmaçları
+#define HPET_CAPABILITIES   0x000
+#define HPET_CONFIG         0x010
+#define HPET_COUNTER        0x0F0
+#define HPET_ENABLE         0x1
+
+#define HPET_CALIBRATE_NS   10000000ULL
+
+static volatile uint64_t timer_ticks = 0;
+
+// Son tarihe göre sıralı bekleyen zamanlayıcılar
+static ktimer_t* timer_queue = NULL;
+
+// HPET ana sayacı ile TSC frekansını ölç
+static bool timer_calibrate_hpet() {
+    acpi_hpet_t* hpet = acpi_get_hpet();
+    if(!hpet || hpet->address == 0 || hpet->address >= 0x100000000ULL) return false;
+
+    volatile uint32_t* regs = (volatile uint32_t*)(uintptr_t)hpet->address;
+    uint32_t period_fs = regs[HPET_CAPABILITIES / 4 + 1];
+    if(period_fs == 0 || period_fs > 100000000) return false;
+
+    regs[HPET_CONFIG / 4] |= HPET_ENABLE;
+
+    // 10 ms'lik HPET sayımı (fs cinsinden süre / periyot)
+    uint32_t ticks = (uint32_t)div_u64(HPET_CALIBRATE_NS * 1000000ULL, period_fs);
+    uint32_t start = regs[HPET_COUNTER / 4];
+    uint64_t tsc_start = rdtsc();
+    while(regs[HPET_COUNTER / 4] - start < ticks) {}
+    uint64_t cycles = rdtsc() - tsc_start;
+
+    // hz = cycles * 1e9 / geçen_ns
+    uint32_t elapsed_ns = (uint32_t)div_u64((uint64_t)ticks * period_fs, 1000000);
+    tsc_set_frequency(div_u64(cycles * 1000000000ULL, elapsed_ns));
+    tsc_set_boot(tsc_start);
+    return true;
+}
+
+// IRQ0: tik say, süresi dolan zamanlayıcıları çalıştır
+static void timer_irq() {
+    timer_ticks++;
+
+    if(!timer_queue) return;
+    uint64_t now = ktime_ns();
+    while(timer_queue && timer_queue->deadline <= now) {
+        ktimer_t* timer = timer_queue;
+        timer_queue = timer->next;
+        timer->next = NULL;
+        timer->active = false;
+        timer->callback(timer->arg);
+    }
+}
+
+// Bekleme sırasında bir sonraki kesmeye kadar uyu
+static void timer_idle() {
+    if(interrupts_enabled) HLT();
+    else __asm__ volatile("pause");
+}
+
+void timer_init() {
+    if(!timer_calibrate_hpet()) {
+        tsc_calibrate();
+    }
+
+    // PIT kanal 0: mod 2 (oran üreteci), TIMER_HZ
+    uint32_t divisor = PIT_FREQUENCY / TIMER_HZ;
+    outb(PIT_COMMAND, 0x34);
+    outb(PIT_CHANNEL0, divisor & 0xFF);
+    outb(PIT_CHANNEL0, (divisor >> 8) & 0xFF);
+
+    register_interrupt_handler(IRQ_BASE + TIMER_IRQ, timer_irq);
+    tsc_set_idle(timer_idle);
+}
+
+uint64_t timer_get_ticks() {
+    return timer_ticks;
+}
+
+// delay_us sonra callback(arg) çağrılır (IRQ bağlamında)
+void ktimer_start(ktimer_t* timer, uint32_t delay_us, void (*callback)(void* arg), void* arg) {
+    ktimer_t** link;
+    bool enabled = interrupts_enabled;
+
+    disable_interrupts();
+    if(timer->active) ktimer_cancel(timer);
+
+    timer->deadline = ktime_ns() + (uint64_t)delay_us * 1000;
+    timer->callback = callback;
+    timer->arg = arg;
+    timer->active = true;
+
+    link = &timer_queue;
+    while(*link && (*link)->deadline <= timer->deadline) {
+        link = &(*link)->next;
+    }
+    timer->next = *link;
+    *link = timer;
+
+    if(enabled) enable_interrupts();
+}
+
+bool ktimer_cancel(ktimer_t* timer) {
+    bool enabled = interrupts_enabled;
+    bool found = false;
+
+    disable_interrupts();
+    for(ktimer_t** link = &timer_queue; *link; link = &(*link)->next) {
+        if(*link == timer) {
+            *link = timer->next;
+            timer->next = NULL;
+            timer->active = false;
+            found = true;
+            break;
+        }
+    }
+    if(enabled) enable_interrupts();
+    return found;
+}
+
+// Sürücü zaman aşımları için: şimdiden timeout_us sonrası
+uint64_t kdeadline_us(uint32_t timeout_us) {
+    return ktime_ns() + (uint64_t)timeout_us * 1000;
+}
+
+bool ktime_expired(uint64_t deadline_ns) {
+    return ktime_ns() >= deadline_ns;
+}
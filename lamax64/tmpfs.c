@@ -0,0 +1,344 @@
+/*
+ * LAMAX64 OS - Bellek İçi Dosya Sistemi (tmpfs)
+ * Version 1.0.0
+ *
+ * Aygıtsız bağlanan, verisi yalnızca RAM'de duran dosya sistemi; geçici
+ * dosyalar için /tmp ve /var'a bağlanır, yeniden başlatmada silinir.
+ *
+ * Dosya verisi sayfa sayfa tutulur. Her dosyanın bir radix ağacı vardır:
+ * ara düğümler de birer sayfadır ve TMPFS_RADIX_SLOTS işaretçi taşır,
+ * yükseklik 0'da kök doğrudan 0. veri sayfasıdır. Ağaç yalnızca gerektikçe
+ * yükselir; yazılmamış sayfalar (delikler) sıfır okunur. Son erişilen
+ * sayfa düğümde saklanır, böylece sıralı okuma ve sona ekleme çoğunlukla
+ * ağacı hiç yürümez; yeni sayfa gerektiğinde yürüyüş en fazla ağaç
+ * yüksekliği kadardır. Veri ve ara düğüm sayfaları PMM'den, düğümler
+ * kendi slab önbelleğinden alınır; sınır yalnızca boş bellektir.
+ *
+ * Düğüm işaretçisi VFS düğüm id'sidir. Açık dosyası olan düğüm silinirse
+ * dizinden hemen çıkarılır ama son kapanışa kadar serbest bırakılmaz.
+ */
+
+#include "system.h"
+
+#define TMPFS_NODE_MAGIC    0x544D5046      // "TMPF"
+
+typedef struct tmpfs_node {
+    uint32_t magic;             // Serbest düğümlerde 0
+    bool is_directory;
+    bool unlinked;              // Dizinden çıktı, son kapanışı bekliyor
+    uint8_t height;             // Radix ağacı yüksekliği
+    uint32_t open_count;
+    char name[MAX_FILENAME];
+    struct tmpfs_node* parent;
+    struct tmpfs_node* first_child;
+    struct tmpfs_node* next_sibling;
+    uint32_t size;
+    void* root;
+
+    // Son erişilen veri sayfası
+    uint32_t cached_index;
+    uint8_t* cached_page;
+} tmpfs_node_t;
+
+static kmem_cache_t* tmpfs_node_cache = NULL;
+static uint32_t tmpfs_pages_used = 0;
+static uint32_t tmpfs_nodes_used = 0;
+
+// Sayfalar
+
+static void* tmpfs_page_alloc() {
+    uintptr_t address = pmm_alloc_page(PMM_ZONE_NORMAL);
+    if(!address) return NULL;
+
+    tmpfs_pages_used++;
+    memset((void*)address, 0, PAGE_SIZE);
+    return (void*)address;
+}
+
+static void tmpfs_page_free(void* page) {
+    pmm_free_page((uintptr_t)page);
+    tmpfs_pages_used--;
+}
+
+// Radix ağacı
+
+// Yükseklik h ağacın kapsadığı sayfa sayısı
+static uint64_t tmpfs_capacity(uint32_t height) {
+    return 1ULL << (TMPFS_RADIX_SHIFT * height);
+}
+
+// index. veri sayfası; create ise eksik ara düğümler ve sayfa ayrılır
+static uint8_t* tmpfs_page(tmpfs_node_t* node, uint32_t index, bool create) {
+    if(node->cached_page && node->cached_index == index) return node->cached_page;
+
+    if(index >= tmpfs_capacity(node->height)) {
+        if(!create) return NULL;
+
+        // Ağacı yükselt: eski kök yeni kökün 0. yuvasına iner
+        while(index >= tmpfs_capacity(node->height)) {
+            if(node->root) {
+                void** parent = tmpfs_page_alloc();
+                if(!parent) return NULL;
+                parent[0] = node->root;
+                node->root = parent;
+            }
+            node->height++;
+        }
+    }
+
+    void** slot = &node->root;
+    for(uint32_t level = node->height; level > 0; level--) {
+        if(!*slot) {
+            if(!create || !(*slot = tmpfs_page_alloc())) return NULL;
+        }
+        uint32_t shift = TMPFS_RADIX_SHIFT * (level - 1);
+        slot = &((void**)*slot)[(index >> shift) & (TMPFS_RADIX_SLOTS - 1)];
+    }
+    if(!*slot) {
+        if(!create || !(*slot = tmpfs_page_alloc())) return NULL;
+    }
+
+    node->cached_index = index;
+    node->cached_page = *slot;
+    return *slot;
+}
+
+static void tmpfs_free_tree(void* page, uint32_t level) {
+    if(!page) return;
+    if(level > 0) {
+        void** slots = page;
+        for(uint32_t i = 0; i < TMPFS_RADIX_SLOTS; i++) tmpfs_free_tree(slots[i], level - 1);
+    }
+    tmpfs_page_free(page);
+}
+
+// Düğümler
+
+static tmpfs_node_t* tmpfs_node(uint64_t id) {
+    tmpfs_node_t* node = (tmpfs_node_t*)(uintptr_t)id;
+    if(!node || node->magic != TMPFS_NODE_MAGIC) return NULL;
+    return node;
+}
+
+static tmpfs_node_t* tmpfs_node_alloc(const char* name, bool is_directory, tmpfs_node_t* parent) {
+    tmpfs_node_t* node = kmem_cache_alloc(tmpfs_node_cache);
+    if(!node) return NULL;
+    tmpfs_nodes_used++;
+
+    memset(node, 0, sizeof(tmpfs_node_t));
+    node->magic = TMPFS_NODE_MAGIC;
+    node->is_directory = is_directory;
+    node->parent = parent;
+    strcpy(node->name, name);
+    return node;
+}
+
+static void tmpfs_node_free(tmpfs_node_t* node) {
+    tmpfs_free_tree(node->root, node->height);
+    node->magic = 0;
+    kmem_cache_free(tmpfs_node_cache, node);
+    tmpfs_nodes_used--;
+}
+
+static tmpfs_node_t* tmpfs_find(tmpfs_node_t* dir, const char* name, tmpfs_node_t** previous) {
+    tmpfs_node_t* last = NULL;
+    for(tmpfs_node_t* node = dir->first_child; node; node = node->next_sibling) {
+        if(strcmp(node->name, name) == 0) {
+            if(previous) *previous = last;
+            return node;
+        }
+        last = node;
+    }
+    return NULL;
+}
+
+// VFS işlemleri
+
+static void tmpfs_fill_node(vfs_mount_t* mount, tmpfs_node_t* tnode, vfs_node_t* node) {
+    node->mount = mount;
+    node->id = (uintptr_t)tnode;
+    node->size = tnode->size;
+    node->attributes = 0;
+    node->is_directory = tnode->is_directory;
+}
+
+static int tmpfs_lookup(vfs_mount_t* mount, const vfs_node_t* dir, const char* name, vfs_node_t* node) {
+    tmpfs_node_t* parent = tmpfs_node(dir->id);
+    if(!parent) return -1;
+
+    tmpfs_node_t* child = tmpfs_find(parent, name, NULL);
+    if(!child) return -1;
+
+    tmpfs_fill_node(mount, child, node);
+    return 0;
+}
+
+// Konum, çocuk listesindeki sıradır (oluşturma sırası)
+static int tmpfs_readdir(vfs_mount_t* mount, file_t* dir, vfs_dirent_t* entry) {
+    (void)mount;
+    tmpfs_node_t* node = tmpfs_node(dir->node.id);
+    if(!node) return -1;
+
+    tmpfs_node_t* child = node->first_child;
+    for(uint32_t i = 0; child && i < dir->position; i++) child = child->next_sibling;
+    if(!child) return 0;
+
+    strcpy(entry->name, child->name);
+    entry->size = child->is_directory ? 0 : child->size;
+    entry->is_directory = child->is_directory;
+    dir->position++;
+    return 1;
+}
+
+static int tmpfs_read(vfs_mount_t* mount, file_t* file, void* buffer, uint32_t size) {
+    (void)mount;
+    tmpfs_node_t* node = tmpfs_node(file->node.id);
+    if(!node) return -1;
+
+    if(file->position >= node->size) return 0;
+    if(size > node->size - file->position) size = node->size - file->position;
+
+    uint8_t* out = buffer;
+    uint32_t position = file->position;
+    uint32_t remaining = size;
+    while(remaining) {
+        uint32_t offset = position % PAGE_SIZE;
+        uint32_t chunk = PAGE_SIZE - offset;
+        if(chunk > remaining) chunk = remaining;
+
+        uint8_t* page = tmpfs_page(node, position / PAGE_SIZE, false);
+        if(page) memcpy(out, page + offset, chunk);
+        else memset(out, 0, chunk);
+
+        out += chunk;
+        position += chunk;
+        remaining -= chunk;
+    }
+    return (int)size;
+}
+
+// Sayfa kalmadıysa yazılabilen kadarı yazılır
+static int tmpfs_write(vfs_mount_t* mount, file_t* file, const void* buffer, uint32_t size) {
+    (void)mount;
+    tmpfs_node_t* node = tmpfs_node(file->node.id);
+    if(!node || node->is_directory) return -1;
+    if(file->position + size < file->position) size = 0xFFFFFFFF - file->position;
+
+    const uint8_t* in = buffer;
+    uint32_t position = file->position;
+    uint32_t written = 0;
+    while(written < size) {
+        uint32_t offset = position % PAGE_SIZE;
+        uint32_t chunk = PAGE_SIZE - offset;
+        if(chunk > size - written) chunk = size - written;
+
+        uint8_t* page = tmpfs_page(node, position / PAGE_SIZE, true);
+        if(!page) break;
+        memcpy(page + offset, in, chunk);
+
+        in += chunk;
+        position += chunk;
+        written += chunk;
+    }
+
+    if(position > node->size) node->size = position;
+    return written ? (int)written : -1;
+}
+
+static int tmpfs_create(vfs_mount_t* mount, const vfs_node_t* dir, const char* name, bool is_directory,
+                        vfs_node_t* node) {
+    tmpfs_node_t* parent = tmpfs_node(dir->id);
+
+    if(!parent || !parent->is_directory || parent->unlinked) return -1;
+    if(strlen(name) == 0 || strlen(name) >= MAX_FILENAME) return -1;
+    if(tmpfs_find(parent, name, NULL)) return -1;
+
+    tmpfs_node_t* child = tmpfs_node_alloc(name, is_directory, parent);
+    if(!child) return -1;
+
+    // Listenin sonuna: ls oluşturma sırasını gösterir
+    tmpfs_node_t** link = &parent->first_child;
+    while(*link) link = &(*link)->next_sibling;
+    *link = child;
+
+    tmpfs_fill_node(mount, child, node);
+    return 0;
+}
+
+static int tmpfs_unlink(vfs_mount_t* mount, const vfs_node_t* dir, const char* name) {
+    (void)mount;
+    tmpfs_node_t* parent = tmpfs_node(dir->id);
+    tmpfs_node_t* previous;
+
+    if(!parent) return -1;
+    tmpfs_node_t* node = tmpfs_find(parent, name, &previous);
+    if(!node) return -1;
+
+    // Boş olmayan dizin silinmez
+    if(node->is_directory && node->first_child) return -1;
+
+    if(previous) previous->next_sibling = node->next_sibling;
+    else parent->first_child = node->next_sibling;
+    node->next_sibling = NULL;
+    node->parent = NULL;
+
+    // Açık dosyalar düğümü hâlâ id'siyle tutuyor: son kapanışta bırakılır
+    if(node->open_count) node->unlinked = true;
+    else tmpfs_node_free(node);
+    return 0;
+}
+
+static int tmpfs_open(vfs_mount_t* mount, const vfs_node_t* node) {
+    (void)mount;
+    tmpfs_node_t* tnode = tmpfs_node(node->id);
+    if(!tnode) return -1;
+
+    tnode->open_count++;
+    return 0;
+}
+
+static void tmpfs_release(vfs_mount_t* mount, const vfs_node_t* node) {
+    (void)mount;
+    tmpfs_node_t* tnode = tmpfs_node(node->id);
+    if(!tnode || tnode->open_count == 0) return;
+
+    if(--tnode->open_count == 0 && tnode->unlinked) tmpfs_node_free(tnode);
+}
+
+// Yalnızca aygıtsız bağlanır; her bağlama kendi kök dizinini alır
+static bool tmpfs_mount(vfs_mount_t* mount) {
+    if(mount->device) return false;
+
+    tmpfs_node_t* root = tmpfs_node_alloc("", true, NULL);
+    if(!root) return false;
+
+    tmpfs_fill_node(mount, root, &mount->root);
+    return true;
+}
+
+static vfs_ops_t tmpfs_ops = {
+    .name = "tmpfs",
+    .mount = tmpfs_mount,
+    .lookup = tmpfs_lookup,
+    .readdir = tmpfs_readdir,
+    .read = tmpfs_read,
+    .create = tmpfs_create,
+    .write = tmpfs_write,
+    .unlink = tmpfs_unlink,
+    .open = tmpfs_open,
+    .release = tmpfs_release,
+};
+
+void tmpfs_usage(uint32_t* pages_used, uint32_t* nodes_used) {
+    *pages_used = tmpfs_pages_used;
+    *nodes_used = tmpfs_nodes_used;
+}
+
+// kmalloc_init'ten sonra çağrılır
+void tmpfs_init() {
+    tmpfs_node_cache = kmem_cache_create("tmpfs_node", sizeof(tmpfs_node_t), 0, NULL);
+    tmpfs_pages_used = 0;
+    tmpfs_nodes_used = 0;
+
+    vfs_register_filesystem(&tmpfs_ops);
+}
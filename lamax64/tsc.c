@@ -0,0 +1,138 @@
+/*
+ * LAMAX64 OS - Zaman Kaynağı (TSC)
+ * Version 1.0.0
+ *
+ * TSC frekansı PIT kanal 2 ile kalibre edilir, zaman TSC'den
+ * nanosaniyeye çarpma + kaydırma ile çevrilir (64-bit bölme yok).
+ * Kernel periyodik zamanlayıcıyı kurunca bekleme döngüleri HLT ile
+ * uyur; öncesinde PAUSE ile döner.
+ */
+
+#include "system.h"
+
+// PIT portları ve giriş frekansı
+#define PIT_CHANNEL2        0x42
+#define PIT_COMMAND         0x43
+#define PIT_GATE_PORT       0x61
+#define PIT_FREQUENCY       1193182
+#define PIT_GATE_HIGH       0x01
+#define PIT_SPEAKER         0x02
+#define PIT_OUT2            0x20
+
+// Kalibrasyon süresi (ms)
+#define TSC_CALIBRATE_MS    10
+
+static uint64_t tsc_hz = 0;
+static uint64_t tsc_boot = 0;
+static uint32_t tsc_mult = 0;
+static uint32_t tsc_shift = 0;
+
+// Bekleme sırasında çağrılan boşta işlevi
+static void (*tsc_idle)() = NULL;
+
+// 64-bit / 32-bit bölme (libgcc __udivdi3 olmadan, ikili uzun bölme)
+uint64_t div_u64(uint64_t dividend, uint32_t divisor) {
+    uint64_t quotient = 0;
+    uint64_t remainder = 0;
+
+    for(int bit = 63; bit >= 0; bit--) {
+        remainder = (remainder << 1) | ((dividend >> bit) & 1);
+        if(remainder >= divisor) {
+            remainder -= divisor;
+            quotient |= 1ULL << bit;
+        }
+    }
+    return quotient;
+}
+
+// ns = (tsc * mult) >> shift, mult 32 bite sığacak en büyük shift ile
+void tsc_set_frequency(uint64_t hz) {
+    uint32_t shift = 32;
+    uint64_t mult;
+
+    // hz 32 bite sığmayabilir: bölmeyi kHz üzerinden yap
+    uint32_t khz = (uint32_t)div_u64(hz, 1000);
+    do {
+        mult = div_u64(1000000ULL << shift, khz);
+    } while((mult >> 32) && --shift);
+
+    tsc_hz = hz;
+    tsc_mult = (uint32_t)mult;
+    tsc_shift = shift;
+}
+
+// PIT kanal 2 tek atımlık sayaç ile TSC frekansını ölç
+bool tsc_calibrate() {
+    uint32_t count = PIT_FREQUENCY / (1000 / TSC_CALIBRATE_MS);
+    uint8_t gate = inb(PIT_GATE_PORT);
+
+    // Hoparlör kapalı, kapı düşük
+    outb(PIT_GATE_PORT, (gate & ~(PIT_SPEAKER | PIT_GATE_HIGH)));
+    outb(PIT_COMMAND, 0xB0);            // Kanal 2, lo/hi, mod 0
+    outb(PIT_CHANNEL2, count & 0xFF);
+    outb(PIT_CHANNEL2, (count >> 8) & 0xFF);
+
+    // Kapıyı kaldırınca sayım başlar, bitince OUT2 yükselir
+    outb(PIT_GATE_PORT, (gate & ~PIT_SPEAKER) | PIT_GATE_HIGH);
+    uint64_t start = rdtsc();
+    while(!(inb(PIT_GATE_PORT) & PIT_OUT2)) {}
+    uint64_t cycles = rdtsc() - start;
+
+    outb(PIT_GATE_PORT, gate);
+    if(cycles == 0) return false;
+
+    tsc_set_frequency(cycles * (1000 / TSC_CALIBRATE_MS));
+    tsc_set_boot(start);
+    return true;
+}
+
+// ktime_ns'in sıfır noktası: kalibrasyonun başladığı an
+void tsc_set_boot(uint64_t tsc) {
+    tsc_boot = tsc;
+}
+
+uint64_t tsc_frequency() {
+    return tsc_hz;
+}
+
+uint64_t tsc_to_ns(uint64_t cycles) {
+    uint64_t high = (cycles >> 32) * tsc_mult;
+    uint64_t low = (cycles & 0xFFFFFFFF) * tsc_mult;
+    return (high << (32 - tsc_shift)) + (low >> tsc_shift);
+}
+
+// Açılıştan beri geçen süre (ns)
+uint64_t ktime_ns() {
+    return tsc_to_ns(rdtsc() - tsc_boot);
+}
+
+void tsc_set_idle(void (*idle)()) {
+    tsc_idle = idle;
+}
+
+// Süre dolana kadar bekle. Boşta işlevi (HLT) sadece bir zamanlayıcı
+// periyodundan uzun beklemelerde kullanılır; kalan kısa süre PAUSE ile
+// beklenir, böylece uyanma gecikmesi bekleme süresine eklenmez.
+void ksleep_until(uint64_t deadline_ns) {
+    uint64_t start = rdtsc();
+
+    for(;;) {
+        uint64_t now = ktime_ns();
+        if(now >= deadline_ns) break;
+
+        if(tsc_idle && deadline_ns - now > TIMER_PERIOD_NS) {
+            tsc_idle();
+        } else {
+            __asm__ volatile("pause");
+        }
+    }
+    boot_profile_add(BOOT_PROFILE_DELAY, rdtsc() - start);
+}
+
+void ksleep_us(uint32_t us) {
+    ksleep_until(ktime_ns() + (uint64_t)us * 1000);
+}
+
+void ksleep_ms(uint32_t ms) {
+    ksleep_until(ktime_ns() + (uint64_t)ms * 1000000);
+}
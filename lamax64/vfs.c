@@ -0,0 +1,330 @@
+/*
+ * LAMAX64 OS - Sanal Dosya Sistemi
+ * Version 1.0.0
+ *
+ * Dosya sistemi türleri vfs_register_filesystem ile kaydolur; vfs_mount
+ * bir blok aygıtını bir yola bağlar (tür verilmezse kayıtlı türler
+ * sırayla denenir). Yol çözümü en uzun eşleşen bağlama noktasından
+ * başlar ve kalan bileşenleri tek tek yürür: her bileşen önce dizin
+ * girdisi önbelleğinde (dcache.c) aranır, türün lookup işlevi yalnızca
+ * ıskalamada çağrılır. Açık dosyalar file_cache slab önbelleğinden
+ * ayrılır ve açıkken dizin girdilerini sabitler; türün open/release
+ * işlevleri varsa açılış ve kapanışta çağrılır.
+ */
+
+#include "system.h"
+
+static vfs_ops_t* vfs_filesystems = NULL;
+static vfs_mount_t vfs_mounts[VFS_MAX_MOUNTS];
+
+void vfs_register_filesystem(vfs_ops_t* ops) {
+    ops->next = vfs_filesystems;
+    vfs_filesystems = ops;
+}
+
+// "." ve ".." bileşenlerini sözcüksel olarak çöz, tekrarlı '/' at.
+// Göreli yollar kökten başlar.
+bool vfs_normalize_path(const char* path, char* out) {
+    int length = 0;
+
+    out[length++] = '/';
+    while(*path) {
+        while(*path == '/') path++;
+        if(!*path) break;
+
+        const char* component = path;
+        int size = 0;
+        while(path[size] && path[size] != '/') size++;
+        path += size;
+
+        if(size == 1 && component[0] == '.') continue;
+        if(size == 2 && component[0] == '.' && component[1] == '.') {
+            while(length > 1 && out[length - 1] != '/') length--;
+            if(length > 1) length--;
+            continue;
+        }
+
+        if(length + size + 2 > MAX_PATH_LENGTH) return false;
+        if(length > 1) out[length++] = '/';
+        for(int i = 0; i < size; i++) out[length++] = component[i];
+    }
+    out[length] = 0;
+    return true;
+}
+
+// Bağlama noktası yolun başında ve bileşen sınırında mı?
+static int vfs_mount_match(const vfs_mount_t* mount, const char* path) {
+    int length = strlen(mount->path);
+
+    if(length == 1) return 1;
+    if(strncmp(mount->path, path, length) != 0) return 0;
+    if(path[length] != 0 && path[length] != '/') return 0;
+    return length;
+}
+
+static vfs_mount_t* vfs_find_mount(const char* path, const char** rest) {
+    vfs_mount_t* best = NULL;
+    int best_length = 0;
+
+    for(int i = 0; i < VFS_MAX_MOUNTS; i++) {
+        if(!vfs_mounts[i].ops) continue;
+        int length = vfs_mount_match(&vfs_mounts[i], path);
+        if(length > best_length) {
+            best = &vfs_mounts[i];
+            best_length = length;
+        }
+    }
+    *rest = path + best_length;
+    return best;
+}
+
+int vfs_mount(const char* path, const char* type, block_device_t* device) {
+    char normalized[MAX_PATH_LENGTH];
+    vfs_mount_t* mount = NULL;
+
+    if(!vfs_normalize_path(path, normalized) || strlen(normalized) >= VFS_MOUNT_PATH) return -1;
+    for(int i = 0; i < VFS_MAX_MOUNTS; i++) {
+        if(vfs_mounts[i].ops && strcmp(vfs_mounts[i].path, normalized) == 0) return -1;
+        if(!vfs_mounts[i].ops && !mount) mount = &vfs_mounts[i];
+    }
+    if(!mount) return -1;
+
+    for(vfs_ops_t* ops = vfs_filesystems; ops; ops = ops->next) {
+        if(type && strcmp(ops->name, type) != 0) continue;
+
+        strcpy(mount->path, normalized);
+        mount->device = device;
+        mount->fs_data = NULL;
+        mount->root.mount = mount;
+        mount->root.is_directory = true;
+        if(ops->mount(mount)) {
+            mount->ops = ops;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+vfs_mount_t* vfs_get_mount(int index) {
+    for(int i = 0; i < VFS_MAX_MOUNTS; i++) {
+        if(vfs_mounts[i].ops && index-- == 0) return &vfs_mounts[i];
+    }
+    return NULL;
+}
+
+// Normalleştirilmiş yolu düğüme çevir; son bileşenin adı name'e, dizin
+// girdisi (varsa) dentry'ye yazılır. Bağlama noktasının girdisi yoktur.
+static int vfs_walk(const char* path, vfs_node_t* node, char* name, dentry_t** dentry) {
+    const char* rest;
+    vfs_mount_t* mount = vfs_find_mount(path, &rest);
+    if(!mount) return -1;
+
+    *node = mount->root;
+    strcpy(name, mount->path);
+    if(dentry) *dentry = NULL;
+
+    while(*rest) {
+        while(*rest == '/') rest++;
+        if(!*rest) break;
+
+        int size = 0;
+        while(rest[size] && rest[size] != '/') size++;
+        if(size >= MAX_FILENAME) return -1;
+        for(int i = 0; i < size; i++) name[i] = rest[i];
+        name[size] = 0;
+        rest += size;
+
+        if(!node->is_directory) return -1;
+        dentry_t* entry = dcache_lookup(mount, node->id, name);
+        if(!entry) {
+            vfs_node_t child;
+            if(mount->ops->lookup(mount, node, name, &child) != 0) {
+                dcache_add(mount, node->id, name, NULL);
+                return -1;
+            }
+            child.mount = mount;
+            entry = dcache_add(mount, node->id, name, &child);
+            if(!entry) {
+                // Önbellek tümüyle sabitli: girdisiz devam et
+                *node = child;
+                if(dentry) *dentry = NULL;
+                continue;
+            }
+        }
+        if(entry->negative) return -1;
+        *node = entry->node;
+        if(dentry) *dentry = entry;
+    }
+    return 0;
+}
+
+int vfs_resolve(const char* path, vfs_node_t* node) {
+    char normalized[MAX_PATH_LENGTH];
+    char name[VFS_MOUNT_PATH];
+
+    if(!vfs_normalize_path(path, normalized)) return -1;
+    return vfs_walk(normalized, node, name, NULL);
+}
+
+// Son bileşenin üst dizinini çöz; bağlama noktasının kendisi üst dizinle
+// değiştirilemez
+static int vfs_walk_parent(const char* path, vfs_node_t* parent, char* name) {
+    char directory[MAX_PATH_LENGTH];
+    const char* rest;
+    int last = 0;
+
+    if(!vfs_find_mount(path, &rest) || *rest == 0) return -1;
+
+    for(int i = 0; path[i]; i++) {
+        if(path[i] == '/') last = i;
+    }
+    if(strlen(path + last + 1) >= MAX_FILENAME) return -1;
+
+    for(int i = 0; i < last; i++) directory[i] = path[i];
+    directory[last ? last : 1] = 0;
+    directory[0] = '/';
+
+    if(vfs_walk(directory, parent, name, NULL) != 0 || !parent->is_directory) return -1;
+    strcpy(name, path + last + 1);
+    return 0;
+}
+
+static file_t* vfs_open_node(const vfs_node_t* node, const char* name, dentry_t* dentry) {
+    file_t* file = kmem_cache_alloc(file_cache);
+    if(!file) return NULL;
+
+    memset(file, 0, sizeof(file_t));
+    file->in_use = true;
+    file->node = *node;
+    file->size = node->size;
+    file->attributes = node->attributes;
+    file->is_directory = node->is_directory;
+    strcpy(file->name, name);
+    readahead_init(&file->readahead);
+
+    vfs_mount_t* mount = node->mount;
+    if(mount->ops->open && mount->ops->open(mount, node) != 0) {
+        kmem_cache_free(file_cache, file);
+        return NULL;
+    }
+    file->dentry = dentry;
+    dcache_get(dentry);
+    return file;
+}
+
+file_t* open_file(const char* filename) {
+    char normalized[MAX_PATH_LENGTH];
+    char name[VFS_MOUNT_PATH];
+    vfs_node_t node;
+    dentry_t* dentry;
+
+    if(!vfs_normalize_path(filename, normalized)) return NULL;
+    if(vfs_walk(normalized, &node, name, &dentry) != 0) return NULL;
+
+    name[MAX_FILENAME - 1] = 0;
+    return vfs_open_node(&node, name, dentry);
+}
+
+static int vfs_create(const char* path, bool is_directory, vfs_node_t* node, char* name, dentry_t** dentry) {
+    char normalized[MAX_PATH_LENGTH];
+    vfs_node_t parent;
+
+    if(!vfs_normalize_path(path, normalized)) return -1;
+    if(vfs_walk_parent(normalized, &parent, name) != 0) return -1;
+
+    vfs_mount_t* mount = parent.mount;
+    if(!mount->ops->create) return -1;
+    if(mount->ops->create(mount, &parent, name, is_directory, node) != 0) return -1;
+    node->mount = mount;
+    // Negatif girdinin yerini alır
+    *dentry = dcache_add(mount, parent.id, name, node);
+    return 0;
+}
+
+// Dosya yoksa oluşturup, varsa olduğu gibi aç
+file_t* create_file(const char* filename) {
+    char name[MAX_FILENAME];
+    vfs_node_t node;
+    dentry_t* dentry;
+
+    file_t* file = open_file(filename);
+    if(file) return file;
+
+    if(vfs_create(filename, false, &node, name, &dentry) != 0) return NULL;
+    return vfs_open_node(&node, name, dentry);
+}
+
+void close_file(file_t* file) {
+    if(!file) return;
+    vfs_mount_t* mount = file->node.mount;
+    if(mount->ops->release) mount->ops->release(mount, &file->node);
+    dcache_put(file->dentry);
+    file->dentry = NULL;
+    file->in_use = false;
+    kmem_cache_free(file_cache, file);
+}
+
+int read_file(file_t* file, void* buffer, uint32_t size) {
+    if(!file || !file->in_use || file->is_directory) return -1;
+    if(size == 0 || file->position >= file->size) return 0;
+    if(size > file->size - file->position) size = file->size - file->position;
+
+    vfs_mount_t* mount = file->node.mount;
+    int result = mount->ops->read(mount, file, buffer, size);
+    if(result > 0) file->position += result;
+    return result;
+}
+
+// Konumdan itibaren yaz; dosya gerekirse büyür
+int write_file(file_t* file, const void* buffer, uint32_t size) {
+    if(!file || !file->in_use || file->is_directory) return -1;
+
+    vfs_mount_t* mount = file->node.mount;
+    if(!mount->ops->write) return -1;
+    if(size == 0) return 0;
+
+    int result = mount->ops->write(mount, file, buffer, size);
+    if(result > 0) {
+        file->position += result;
+        if(file->position > file->size) file->size = file->position;
+        file->node.size = file->size;
+        if(file->dentry) file->dentry->node.size = file->size;
+    }
+    return result;
+}
+
+int read_directory(file_t* dir, vfs_dirent_t* entry) {
+    if(!dir || !dir->in_use || !dir->is_directory) return -1;
+
+    vfs_mount_t* mount = dir->node.mount;
+    return mount->ops->readdir(mount, dir, entry);
+}
+
+bool create_directory(const char* dirname) {
+    char name[MAX_FILENAME];
+    vfs_node_t node;
+    dentry_t* dentry;
+
+    return vfs_create(dirname, true, &node, name, &dentry) == 0;
+}
+
+bool delete_file(const char* filename) {
+    char normalized[MAX_PATH_LENGTH];
+    char name[MAX_FILENAME];
+    vfs_node_t parent;
+    vfs_node_t node;
+
+    if(!vfs_normalize_path(filename, normalized)) return false;
+    if(vfs_walk_parent(normalized, &parent, name) != 0) return false;
+
+    vfs_mount_t* mount = parent.mount;
+    if(!mount->ops->unlink) return false;
+
+    // Silinen dizinin id'si yeniden kullanılabilir: altındaki girdiler de gider
+    bool found = vfs_resolve(normalized, &node) == 0;
+    if(mount->ops->unlink(mount, &parent, name) != 0) return false;
+
+    if(found && node.is_directory) dcache_invalidate_dir(mount, node.id);
+    dcache_add(mount, parent.id, name, NULL);
+    return true;
+}
@@ -0,0 +1,330 @@
+/*
+ * LAMAX64 OS - Sanal Bellek Yöneticisi
+ * Version 1.0.0
+ *
+ * entry.asm'nin geçici 4 GB eşlemini kalıcı 4 düzeyli tablolarla
+ * değiştirir. Fiziksel belleğin tamamı (en az 4 GB: MMIO da içinde)
+ * VMM_DIRECT_BASE'ten itibaren işlemci destekliyorsa 1 GB, yoksa 2 MB
+ * sayfalarla eşlenir; birkaç yüz TLB girdisi tüm belleği kapsar. PML4[0]
+ * aynı PDPT'yi gösterdiği için kernelin birebir adresleri de geçerli
+ * kalır. Bu tablolar .bss'tedir: pmm_init'ten önce kurulur ve pmm'nin
+ * erişebileceği sınırı (vmm_mapped_limit) belirler.
+ *
+ * vmalloc alanındaki eşlemler 4 KB'lık ve global olmayan sayfalardır;
+ * ara tablolar pmm'den gelir ve bir daha bırakılmaz. Kaldırma önce
+ * girdilerin yalnızca P bitini siler, TLB'yi bir kerede temizler
+ * (VMM_TLB_BATCH sayfaya kadar invlpg, fazlasında CR3), fiziksel
+ * sayfalar ancak ondan sonra geri verilir.
+ */
+
+#include "system.h"
+
+#define VMM_ENTRIES         512
+#define VMM_ADDRESS_MASK    0x000FFFFFFFFFF000ULL
+#define VMM_GB              0x40000000ULL
+#define VMM_2MB             0x200000ULL
+#define VMM_MIN_LIMIT       0x100000000ULL      // LAPIC, IOAPIC, PCI BAR'ları
+#define VMM_STATIC_PDS      64                  // 2 MB sayfalarla en fazla 64 GB
+
+// level 3: PML4 ... level 0: PT
+#define VMM_INDEX(address, level)   (((address) >> (12 + 9 * (level))) & (VMM_ENTRIES - 1))
+
+#define CPUID_EXT_PDPE1GB   (1u << 26)          // 0x80000001 EDX
+#define CPUID_PGE           (1u << 13)          // 1 EDX
+#define CR4_PGE             (1u << 7)
+
+typedef uint64_t vmm_entry_t;
+
+// vmalloc alanı; başlangıca göre sıralı, aralarda en az bir koruma sayfası
+typedef struct vmm_area {
+    uintptr_t start;
+    uint32_t pages;
+    struct vmm_area* next;
+} vmm_area_t;
+
+static vmm_entry_t vmm_pml4[VMM_ENTRIES] __attribute__((aligned(PAGE_SIZE)));
+static vmm_entry_t vmm_direct_pdpt[VMM_ENTRIES] __attribute__((aligned(PAGE_SIZE)));
+static vmm_entry_t vmm_direct_pds[VMM_STATIC_PDS][VMM_ENTRIES] __attribute__((aligned(PAGE_SIZE)));
+
+static vmm_area_t* vmm_areas = NULL;
+static vmm_stats_t vmm_stats;
+static spinlock_t vmm_lock;
+
+static inline void cpuid(uint32_t leaf, uint32_t* eax, uint32_t* ebx, uint32_t* ecx, uint32_t* edx) {
+    __asm__ volatile("cpuid" : "=a"(*eax), "=b"(*ebx), "=c"(*ecx), "=d"(*edx) : "a"(leaf), "c"(0));
+}
+
+static inline uintptr_t read_cr3() {
+    uintptr_t value;
+    __asm__ volatile("mov %%cr3, %0" : "=r"(value));
+    return value;
+}
+
+static inline void write_cr3(uintptr_t value) {
+    __asm__ volatile("mov %0, %%cr3" : : "r"(value) : "memory");
+}
+
+static inline uintptr_t read_cr4() {
+    uintptr_t value;
+    __asm__ volatile("mov %%cr4, %0" : "=r"(value));
+    return value;
+}
+
+static inline void write_cr4(uintptr_t value) {
+    __asm__ volatile("mov %0, %%cr4" : : "r"(value) : "memory");
+}
+
+static inline void invlpg(uintptr_t address) {
+    __asm__ volatile("invlpg (%0)" : : "r"(address) : "memory");
+}
+
+void vmm_init() {
+    uint32_t eax, ebx, ecx, edx;
+    bool huge = false;
+    cpuid(0x80000000, &eax, &ebx, &ecx, &edx);
+    if(eax >= 0x80000001) {
+        cpuid(0x80000001, &eax, &ebx, &ecx, &edx);
+        huge = (edx & CPUID_EXT_PDPE1GB) != 0;
+    }
+    cpuid(1, &eax, &ebx, &ecx, &edx);
+    bool global = (edx & CPUID_PGE) != 0;
+
+    // pmm_init henüz yok: haritayı doğrudan oku, en yüksek kullanılabilir adres
+    uint64_t limit = VMM_MIN_LIMIT;
+    const e820_map_t* map = (const e820_map_t*)E820_MAP_ADDR;
+    if(map->count <= E820_MAX_ENTRIES) {
+        for(int i = 0; i < map->count; i++) {
+            const e820_entry_t* entry = &map->entries[i];
+            uint64_t end = entry->base + entry->length;
+            if(entry->type == E820_USABLE && end > limit) limit = end;
+        }
+    }
+    uint64_t max = huge ? VMM_DIRECT_MAX : VMM_STATIC_PDS * VMM_GB;
+    if(limit > max) limit = max;
+    uint32_t gigabytes = (uint32_t)((limit + VMM_GB - 1) / VMM_GB);
+
+    vmm_entry_t flags = VMM_PRESENT | VMM_WRITE | VMM_HUGE | (global ? VMM_GLOBAL : 0);
+    for(uint32_t i = 0; i < gigabytes; i++) {
+        uint64_t base = (uint64_t)i * VMM_GB;
+        if(huge) {
+            vmm_direct_pdpt[i] = base | flags;
+            continue;
+        }
+        for(int j = 0; j < VMM_ENTRIES; j++) vmm_direct_pds[i][j] = (base + j * VMM_2MB) | flags;
+        vmm_direct_pdpt[i] = (uintptr_t)vmm_direct_pds[i] | VMM_PRESENT | VMM_WRITE;
+    }
+
+    // Kernel birebir bağlanmış: tabloların adresleri fiziksel adresleridir
+    vmm_entry_t pdpt = (uintptr_t)vmm_direct_pdpt | VMM_PRESENT | VMM_WRITE;
+    vmm_pml4[0] = pdpt;
+    vmm_pml4[VMM_INDEX(VMM_DIRECT_BASE, 3)] = pdpt;
+
+    write_cr3((uintptr_t)vmm_pml4);
+    if(global) write_cr4(read_cr4() | CR4_PGE);
+
+    vmm_areas = NULL;
+    vmm_stats = (vmm_stats_t){0};
+    vmm_stats.mapped_limit = (uint64_t)gigabytes * VMM_GB;
+    vmm_stats.direct_page_size = huge ? VMM_GB : VMM_2MB;
+    vmm_stats.global_pages = global;
+}
+
+uint64_t vmm_mapped_limit() {
+    // vmm_init'ten önce yalnızca entry.asm'nin 4 GB'ı var
+    return vmm_stats.mapped_limit ? vmm_stats.mapped_limit : VMM_MIN_LIMIT;
+}
+
+// virt'in PT girdisi; create ile eksik ara tablolar ayrılır. Büyük sayfa
+// içine düşen adres (doğrudan eşlem) bölünmez, NULL döner.
+static vmm_entry_t* vmm_walk(uintptr_t virt, bool create) {
+    vmm_entry_t* table = vmm_pml4;
+    for(int level = 3; level > 0; level--) {
+        vmm_entry_t* entry = &table[VMM_INDEX(virt, level)];
+        if(!(*entry & VMM_PRESENT)) {
+            if(!create) return NULL;
+            uintptr_t page = pmm_alloc_page(PMM_ZONE_NORMAL);
+            if(!page) return NULL;
+            memset(phys_to_virt(page), 0, PAGE_SIZE);
+            *entry = page | VMM_PRESENT | VMM_WRITE;
+            vmm_stats.table_pages++;
+        } else if(*entry & VMM_HUGE) {
+            return NULL;
+        }
+        table = phys_to_virt(*entry & VMM_ADDRESS_MASK);
+    }
+    return &table[VMM_INDEX(virt, 0)];
+}
+
+// Global olmayan girdiler için: az sayfada invlpg, çoğunda CR3
+static void vmm_flush(uintptr_t virt, uint32_t count) {
+    if(count > VMM_TLB_BATCH) {
+        write_cr3(read_cr3());
+        vmm_stats.full_flushes++;
+        return;
+    }
+    for(uint32_t i = 0; i < count; i++) invlpg(virt + (uintptr_t)i * PAGE_SIZE);
+    vmm_stats.invlpg_count += count;
+}
+
+// Önce P bitleri silinir (adres girdide kalır), TLB bir kerede temizlenir,
+// sonra girdiler sıfırlanır ve istenirse fiziksel sayfalar bırakılır
+static void vmm_unmap_locked(uintptr_t virt, uint32_t count, bool release) {
+    for(uint32_t i = 0; i < count; i++) {
+        vmm_entry_t* entry = vmm_walk(virt + (uintptr_t)i * PAGE_SIZE, false);
+        if(entry) *entry &= ~(vmm_entry_t)VMM_PRESENT;
+    }
+    vmm_flush(virt, count);
+
+    for(uint32_t i = 0; i < count; i++) {
+        vmm_entry_t* entry = vmm_walk(virt + (uintptr_t)i * PAGE_SIZE, false);
+        if(!entry || !*entry) continue;
+        if(release) pmm_free_page(*entry & VMM_ADDRESS_MASK);
+        *entry = 0;
+    }
+}
+
+// [virt, virt + count sayfa) -> [phys, ...). Doğrudan eşlem alanına
+// dokunulamaz; VMM_GLOBAL yok sayılır ki CR3 yüklemek temizlemeye yetsin.
+int vmm_map(uintptr_t virt, uintptr_t phys, uint32_t count, uint32_t flags) {
+    if((virt | phys) & (PAGE_SIZE - 1)) return -1;
+    flags = (flags & ~(VMM_GLOBAL | VMM_HUGE)) | VMM_PRESENT;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&vmm_lock);
+
+    uint32_t stale = 0;
+    int result = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        uintptr_t address = virt + (uintptr_t)i * PAGE_SIZE;
+        vmm_entry_t* entry = vmm_walk(address, true);
+        if(!entry) {
+            vmm_unmap_locked(virt, i, false);
+            result = -1;
+            break;
+        }
+        if(*entry & VMM_PRESENT) stale++;
+        *entry = (phys + (uintptr_t)i * PAGE_SIZE) | flags;
+    }
+    // Yerine yazılan eşlem varsa eski çeviriler atılmalı
+    if(stale && result == 0) vmm_flush(virt, count);
+
+    spin_unlock(&vmm_lock);
+    if(enabled) enable_interrupts();
+    return result;
+}
+
+void vmm_unmap(uintptr_t virt, uint32_t count) {
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&vmm_lock);
+    vmm_unmap_locked(virt, count, false);
+    spin_unlock(&vmm_lock);
+    if(enabled) enable_interrupts();
+}
+
+// Eşlenmemişse 0; tablolar hiç bırakılmadığı için kilitsiz okunur
+uintptr_t vmm_translate(uintptr_t virt) {
+    vmm_entry_t* table = vmm_pml4;
+    for(int level = 3; level >= 0; level--) {
+        vmm_entry_t entry = table[VMM_INDEX(virt, level)];
+        if(!(entry & VMM_PRESENT)) return 0;
+
+        uint64_t size = 1ULL << (12 + 9 * level);
+        if(level == 0 || (entry & VMM_HUGE)) {
+            return (uintptr_t)((entry & VMM_ADDRESS_MASK & ~(size - 1)) | (virt & (size - 1)));
+        }
+        table = phys_to_virt(entry & VMM_ADDRESS_MASK);
+    }
+    return 0;
+}
+
+// Alanı listeden çıkarır, ilk pages sayfasının eşlemini ve belleğini
+// bırakır (vmm_lock tutulurken)
+static void vmm_area_release(vmm_area_t* area, uint32_t pages) {
+    for(vmm_area_t** link = &vmm_areas; *link; link = &(*link)->next) {
+        if(*link == area) {
+            *link = area->next;
+            break;
+        }
+    }
+    vmm_unmap_locked(area->start, pages, true);
+    vmm_stats.vmalloc_areas--;
+    vmm_stats.vmalloc_pages -= area->pages;
+}
+
+// Sanal olarak bitişik, fiziksel olarak dağınık bellek. İlk uyan boşluk;
+// her alanın ardında eşlenmemiş bir koruma sayfası bırakılır.
+void* vmalloc(uint32_t size) {
+    if(size == 0) return NULL;
+    uint32_t pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+    if(pages >= VMM_VMALLOC_SIZE / PAGE_SIZE) return NULL;
+
+    vmm_area_t* area = kmalloc(sizeof(vmm_area_t));
+    if(!area) return NULL;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&vmm_lock);
+
+    uintptr_t span = (uintptr_t)(pages + 1) * PAGE_SIZE;
+    uintptr_t start = (uintptr_t)VMM_VMALLOC_BASE;
+    vmm_area_t** link = &vmm_areas;
+    while(*link && (*link)->start < start + span) {
+        start = (*link)->start + (uintptr_t)((*link)->pages + 1) * PAGE_SIZE;
+        link = &(*link)->next;
+    }
+    bool fits = start + span <= (uintptr_t)(VMM_VMALLOC_BASE + VMM_VMALLOC_SIZE);
+    if(fits) {
+        // Sayfa sayısı şimdiden yazılır ki doldurulurken alan çakışmasın
+        area->start = start;
+        area->pages = pages;
+        area->next = *link;
+        *link = area;
+        vmm_stats.vmalloc_areas++;
+        vmm_stats.vmalloc_pages += pages;
+    }
+
+    spin_unlock(&vmm_lock);
+    if(enabled) enable_interrupts();
+    if(!fits) {
+        kfree(area);
+        return NULL;
+    }
+
+    // Sayfalar kilit dışında tek tek doldurulur
+    for(uint32_t i = 0; i < pages; i++) {
+        uintptr_t phys = pmm_alloc_page(PMM_ZONE_NORMAL);
+        if(!phys || vmm_map(start + (uintptr_t)i * PAGE_SIZE, phys, 1, VMM_WRITE) != 0) {
+            if(phys) pmm_free_page(phys);
+            disable_interrupts();
+            spin_lock(&vmm_lock);
+            vmm_area_release(area, i);
+            spin_unlock(&vmm_lock);
+            if(enabled) enable_interrupts();
+            kfree(area);
+            return NULL;
+        }
+    }
+    return (void*)start;
+}
+
+void vfree(void* ptr) {
+    if(!ptr) return;
+
+    bool enabled = interrupts_enabled;
+    disable_interrupts();
+    spin_lock(&vmm_lock);
+
+    vmm_area_t* area = vmm_areas;
+    while(area && area->start != (uintptr_t)ptr) area = area->next;
+    if(area) vmm_area_release(area, area->pages);
+
+    spin_unlock(&vmm_lock);
+    if(enabled) enable_interrupts();
+    if(area) kfree(area);
+}
+
+void vmm_get_stats(vmm_stats_t* stats) {
+    *stats = vmm_stats;
+}